@@ -0,0 +1,494 @@
+// Generated by StaticDictGen from A1_input.txt, do not edit.
+#ifndef A1_DICTIONARY_H
+#define A1_DICTIONARY_H
+
+#include "WordView.h"
+
+static constexpr WordView A1_dictionary_words_0[] = {
+    WordView("T-shirt"),
+    WordView("backpack"),
+    WordView("bag"),
+    WordView("belt"),
+    WordView("blouse"),
+    WordView("boot"),
+    WordView("bracelet"),
+    WordView("button"),
+    WordView("cap"),
+    WordView("chain"),
+    WordView("clothes"),
+    WordView("coat"),
+    WordView("collar"),
+    WordView("costume"),
+    WordView("cotton"),
+    WordView("dress"),
+    WordView("earring"),
+    WordView("fashion"),
+    WordView("fasten"),
+    WordView("fit(v)"),
+    WordView("fold(v)"),
+    WordView("glasses"),
+    WordView("glove"),
+    WordView("go(with/together)"),
+    WordView("handbag"),
+    WordView("handkerchief"),
+    WordView("hat"),
+    WordView("jacket"),
+    WordView("jeans"),
+    WordView("jewellery/jewelry"),
+    WordView("jumper"),
+    WordView("kit"),
+    WordView("knit"),
+    WordView("label"),
+    WordView("laundry"),
+    WordView("leather"),
+    WordView("make-up"),
+    WordView("match(v)"),
+    WordView("material"),
+    WordView("necklace"),
+    WordView("old-fashioned(adj)"),
+    WordView("pants"),
+    WordView("pattern"),
+    WordView("perfume"),
+    WordView("plastic"),
+    WordView("pocket"),
+    WordView("pullover"),
+    WordView("purse"),
+    WordView("put on"),
+    WordView("raincoat"),
+    WordView("ring"),
+    WordView("sandal"),
+    WordView("scarf"),
+    WordView("shirt"),
+    WordView("shoe"),
+    WordView("shorts"),
+    WordView("silk"),
+    WordView("size"),
+    WordView("skirt"),
+    WordView("sleeve(less)"),
+    WordView("socks"),
+    WordView("stripe"),
+    WordView("suit"),
+    WordView("sunglasses"),
+    WordView("sweater"),
+    WordView("sweatshirt"),
+    WordView("sweatshirt"),
+    WordView("swimming"),
+    WordView("swimsuit"),
+    WordView("take off"),
+    WordView("tie"),
+    WordView("tights"),
+    WordView("tracksuit"),
+    WordView("trainers"),
+    WordView("trousers"),
+    WordView("try on"),
+    WordView("umbrella"),
+    WordView("underpants"),
+    WordView("underwear"),
+    WordView("undress"),
+    WordView("uniform"),
+    WordView("wallet"),
+    WordView("watch"),
+    WordView("wear(out)"),
+    WordView("wool(len)"),
+};
+static_assert(wordViewsSorted(A1_dictionary_words_0, 0, 85), "A1_dictionary_words_0 must be sorted");
+
+static constexpr WordView A1_dictionary_words_1[] = {
+    WordView("(dark/light/pale)"),
+    WordView("apricot"),
+    WordView("aquamarine"),
+    WordView("bittersweet"),
+    WordView("black"),
+    WordView("black"),
+    WordView("blue"),
+    WordView("blue"),
+    WordView("blueGreen"),
+    WordView("blueViolet"),
+    WordView("brickRed"),
+    WordView("brown"),
+    WordView("brown"),
+    WordView("burntOrange"),
+    WordView("cadetBlue"),
+    WordView("carnationPink"),
+    WordView("cerulean"),
+    WordView("cornflowerBlue"),
+    WordView("cyan"),
+    WordView("dandelion"),
+    WordView("darkOrchid"),
+    WordView("emerald"),
+    WordView("forestGreen"),
+    WordView("fuchsia"),
+    WordView("gold"),
+    WordView("golden"),
+    WordView("goldenrod"),
+    WordView("gray"),
+    WordView("green"),
+    WordView("green"),
+    WordView("greenYellow"),
+    WordView("grey"),
+    WordView("jungleGreen"),
+    WordView("lavender"),
+    WordView("limeGreen"),
+    WordView("magenta"),
+    WordView("mahogany"),
+    WordView("maroon"),
+    WordView("melon"),
+    WordView("midnightBlue"),
+    WordView("mulberry"),
+    WordView("navyBlue"),
+    WordView("oliveGreen"),
+    WordView("orange"),
+    WordView("orange"),
+    WordView("orangeRed"),
+    WordView("orchid"),
+    WordView("peach"),
+    WordView("periwinkle"),
+    WordView("pineGreen"),
+    WordView("pink"),
+    WordView("plum"),
+    WordView("processBlue"),
+    WordView("purple"),
+    WordView("purple"),
+    WordView("rawSienna"),
+    WordView("red"),
+    WordView("red"),
+    WordView("redOrange"),
+    WordView("redViolet"),
+    WordView("rhodamine"),
+    WordView("royalBlue"),
+    WordView("royalPurple"),
+    WordView("rubineRed"),
+    WordView("salmon"),
+    WordView("seaGreen"),
+    WordView("sepia"),
+    WordView("silver"),
+    WordView("skyBlue"),
+    WordView("springGreen"),
+    WordView("tan"),
+    WordView("tealBlue"),
+    WordView("thistle"),
+    WordView("turquoise"),
+    WordView("violet"),
+    WordView("violetRed"),
+    WordView("white"),
+    WordView("white"),
+    WordView("wildStrawberry"),
+    WordView("yellow"),
+    WordView("yellow"),
+    WordView("yellowGreen"),
+    WordView("yellowOrange"),
+};
+static_assert(wordViewsSorted(A1_dictionary_words_1, 0, 83), "A1_dictionary_words_1 must be sorted");
+
+static constexpr WordView A1_dictionary_words_2[] = {
+    WordView("(computer)"),
+    WordView("CD (player)"),
+    WordView("CD-Rom"),
+    WordView("DVD (player)"),
+    WordView("IT"),
+    WordView("MP3"),
+    WordView("PC"),
+    WordView("access"),
+    WordView("address"),
+    WordView("at!@"),
+    WordView("blog"),
+    WordView("blogger"),
+    WordView("by post"),
+    WordView("call(v)"),
+    WordView("callback"),
+    WordView("camera"),
+    WordView("chat"),
+    WordView("chat"),
+    WordView("click(v)"),
+    WordView("computer"),
+    WordView("connect"),
+    WordView("connection"),
+    WordView("delete"),
+    WordView("dial"),
+    WordView("dial"),
+    WordView("digital"),
+    WordView("digital"),
+    WordView("disc/disk"),
+    WordView("dot"),
+    WordView("download(n&v)"),
+    WordView("drag"),
+    WordView("electronic(s)"),
+    WordView("email"),
+    WordView("engaged"),
+    WordView("enter"),
+    WordView("envelope"),
+    WordView("equipment"),
+    WordView("fax"),
+    WordView("file"),
+    WordView("hang"),
+    WordView("hardware"),
+    WordView("headline"),
+    WordView("homepage"),
+    WordView("install"),
+    WordView("internet"),
+    WordView("invent"),
+    WordView("invention"),
+    WordView("keyboard"),
+    WordView("laptop"),
+    WordView("machine"),
+    WordView("mat"),
+    WordView("message"),
+    WordView("mobile"),
+    WordView("mouse"),
+    WordView("mouse"),
+    WordView("net"),
+    WordView("online"),
+    WordView("operator"),
+    WordView("parcelcalculator"),
+    WordView("password"),
+    WordView("phone"),
+    WordView("phone"),
+    WordView("photograph"),
+    WordView("photography"),
+    WordView("player"),
+    WordView("postcard"),
+    WordView("print"),
+    WordView("printer"),
+    WordView("program(me)"),
+    WordView("reply"),
+    WordView("ring"),
+    WordView("ring up"),
+    WordView("room"),
+    WordView("screen"),
+    WordView("server"),
+    WordView("software"),
+    WordView("switch off"),
+    WordView("switch on"),
+    WordView("talk"),
+    WordView("telephone"),
+    WordView("text"),
+    WordView("text message"),
+    WordView("turn off"),
+    WordView("turn on"),
+    WordView("up"),
+    WordView("up"),
+    WordView("upload"),
+    WordView("video clip"),
+    WordView("volume"),
+    WordView("web"),
+    WordView("web page"),
+    WordView("webcam"),
+    WordView("website"),
+};
+static_assert(wordViewsSorted(A1_dictionary_words_2, 0, 93), "A1_dictionary_words_2 must be sorted");
+
+static constexpr WordView A1_dictionary_words_3[] = {
+    WordView("IT"),
+    WordView("absent"),
+    WordView("advanced"),
+    WordView("arithmetic"),
+    WordView("art"),
+    WordView("beginner"),
+    WordView("bell"),
+    WordView("biology"),
+    WordView("blackboard"),
+    WordView("board"),
+    WordView("board"),
+    WordView("book"),
+    WordView("bookshelf"),
+    WordView("break up"),
+    WordView("break(time)"),
+    WordView("certificate"),
+    WordView("chemistry"),
+    WordView("class"),
+    WordView("classroom"),
+    WordView("clever"),
+    WordView("coach"),
+    WordView("college"),
+    WordView("composition"),
+    WordView("course"),
+    WordView("curriculum"),
+    WordView("degree"),
+    WordView("desk"),
+    WordView("dictionary"),
+    WordView("diploma"),
+    WordView("drama"),
+    WordView("economics"),
+    WordView("elementary"),
+    WordView("essay"),
+    WordView("geography"),
+    WordView("handwriting"),
+    WordView("history"),
+    WordView("homework"),
+    WordView("information"),
+    WordView("instructions"),
+    WordView("instructor"),
+    WordView("intermediate"),
+    WordView("know"),
+    WordView("laboratory (lab)"),
+    WordView("language"),
+    WordView("learn"),
+    WordView("lesson"),
+    WordView("level"),
+    WordView("library"),
+    WordView("mark"),
+    WordView("math(s)"),
+    WordView("mathematics"),
+    WordView("music"),
+    WordView("nature"),
+    WordView("note"),
+    WordView("notice"),
+    WordView("pencil case"),
+    WordView("photography"),
+    WordView("physics"),
+    WordView("practice(n)"),
+    WordView("practise(v)"),
+    WordView("primary"),
+    WordView("project"),
+    WordView("pupil"),
+    WordView("qualification"),
+    WordView("read"),
+    WordView("register"),
+    WordView("remember"),
+    WordView("rubber"),
+    WordView("ruler"),
+    WordView("school"),
+    WordView("school"),
+    WordView("school"),
+    WordView("science"),
+    WordView("secondary"),
+    WordView("student"),
+    WordView("studies"),
+    WordView("studies"),
+    WordView("study(v)"),
+    WordView("subject"),
+    WordView("teach"),
+    WordView("teacher"),
+    WordView("technology"),
+    WordView("term"),
+    WordView("test"),
+    WordView("university"),
+};
+static_assert(wordViewsSorted(A1_dictionary_words_3, 0, 85), "A1_dictionary_words_3 must be sorted");
+
+static constexpr WordView A1_dictionary_words_4[] = {
+    WordView("CD (player)"),
+    WordView("CO-Rom"),
+    WordView("MP3"),
+    WordView("act (v)"),
+    WordView("action"),
+    WordView("actor"),
+    WordView("actress"),
+    WordView("ad"),
+    WordView("admission"),
+    WordView("adventure"),
+    WordView("advert"),
+    WordView("advertisement"),
+    WordView("art"),
+    WordView("article"),
+    WordView("audience"),
+    WordView("ballet"),
+    WordView("band"),
+    WordView("board"),
+    WordView("book"),
+    WordView("camera"),
+    WordView("card"),
+    WordView("cartoon"),
+    WordView("celebrity DVD (player) "),
+    WordView("channel"),
+    WordView("chat"),
+    WordView("chess"),
+    WordView("cinema"),
+    WordView("circus"),
+    WordView("classical"),
+    WordView("comedy"),
+    WordView("comic"),
+    WordView("competition"),
+    WordView("concert"),
+    WordView("dance"),
+    WordView("dancer"),
+    WordView("disc"),
+    WordView("disc jockey"),
+    WordView("disco"),
+    WordView("display"),
+    WordView("documentary"),
+    WordView("drama"),
+    WordView("draw"),
+    WordView("drawing"),
+    WordView("entrance"),
+    WordView("exhibition"),
+    WordView("exit"),
+    WordView("festival"),
+    WordView("film"),
+    WordView("film"),
+    WordView("film"),
+    WordView("fireworks"),
+    WordView("folk"),
+    WordView("fun"),
+    WordView("game"),
+    WordView("go out"),
+    WordView("group"),
+    WordView("guitar"),
+    WordView("guitarist"),
+    WordView("headline"),
+    WordView("hero"),
+    WordView("heroine"),
+    WordView("hip"),
+    WordView("hit"),
+    WordView("hop"),
+    WordView("horror"),
+    WordView("instrument"),
+    WordView("interval"),
+    WordView("interview(er)"),
+    WordView("jazz"),
+    WordView("journalist"),
+    WordView("keyboard"),
+    WordView("laugh"),
+    WordView("listen to"),
+    WordView("look at"),
+    WordView("magazine"),
+    WordView("magic"),
+    WordView("maker"),
+    WordView("museum"),
+    WordView("music"),
+    WordView("music"),
+    WordView("music"),
+    WordView("music"),
+    WordView("music"),
+    WordView("musician"),
+    WordView("news"),
+    WordView("newspaper"),
+    WordView("opera"),
+    WordView("orchestra"),
+    WordView("paint"),
+    WordView("painter"),
+    WordView("perform"),
+    WordView("performance"),
+    WordView("performer"),
+    WordView("play"),
+    WordView("player"),
+    WordView("poem"),
+    WordView("pop"),
+    WordView("programme"),
+    WordView("quiz"),
+    WordView("recording"),
+    WordView("review"),
+    WordView("rock music"),
+    WordView("romantic"),
+    WordView("row"),
+    WordView("scene"),
+    WordView("show"),
+    WordView("soap opera"),
+    WordView("song"),
+    WordView("stage"),
+    WordView("star"),
+    WordView("talk show"),
+    WordView("television"),
+};
+static_assert(wordViewsSorted(A1_dictionary_words_4, 0, 112), "A1_dictionary_words_4 must be sorted");
+
+static constexpr StaticCategory A1_dictionary[] = {
+    {"Clothes and Accessories", A1_dictionary_words_0, 85},
+    {"Colours", A1_dictionary_words_1, 83},
+    {"Communications and Technology", A1_dictionary_words_2, 93},
+    {"Education", A1_dictionary_words_3, 85},
+    {"Entertainment and Media", A1_dictionary_words_4, 112},
+};
+static constexpr size_t A1_dictionary_count = 5;
+
+#endif // A1_DICTIONARY_H
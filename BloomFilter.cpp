@@ -0,0 +1,137 @@
+#include "BloomFilter.h"
+#include <cmath> // log, ceil
+
+// Default constructor : no blocks at all
+BloomFilter::BloomFilter() : block_count(0), max_keys(0), rate(1.0), hash_count(0) {}
+
+// Constructor : BloomFilter filter(1000, 0.01); sized with the textbook formulas
+//   bits per key = -ln(p) / ln(2)^2 , hash functions = bits per key * ln(2)
+// then given more bits per key until the rate holds with blocks : some blocks get more keys than the average
+BloomFilter::BloomFilter(size_t capacity, double false_positive_rate)
+    : block_count(0), max_keys(capacity), rate(false_positive_rate), hash_count(0)
+{
+    if (rate <= 0.0 || rate >= 1.0)
+    {
+        rate = 0.01;
+    }
+    double ln2 = std::log(2.0);
+    double bits_per_key = -std::log(rate) / (ln2 * ln2);
+    hash_count = static_cast<unsigned>(bits_per_key * ln2 + 0.5);
+    if (hash_count < 1)
+    {
+        hash_count = 1;
+    }
+    if (hash_count > 16)
+    {
+        hash_count = 16;
+    }
+    while (blockedRate(bits_per_key, hash_count) > rate) // 2% more at a time : at most about 15% in all, at p = 0.0001
+    {
+        bits_per_key *= 1.02;
+    }
+    size_t total_bits = static_cast<size_t>(std::ceil(bits_per_key * (capacity > 0 ? capacity : 1)));
+    block_count = (total_bits + BLOCK_WORDS * 64 - 1) / (BLOCK_WORDS * 64);
+    bits.assign(block_count * BLOCK_WORDS, 0);
+}
+
+// False-positive rate of a full filter with blocks : the keys of a block follow a Poisson distribution around the
+// average, and a block holding i keys answers "maybe" with the textbook rate of a 512-bit filter holding i keys
+double BloomFilter::blockedRate(double bits_per_key, unsigned hashes)
+{
+    const double block_bits = BLOCK_WORDS * 64;
+    double average = block_bits / bits_per_key; // keys per block
+    double probability = std::exp(-average);   // of a block holding i keys, starting at i = 0
+    double bit_clear = 1.0;                     // chance that one bit is still 0 after i keys
+    double step = std::pow(1.0 - 1.0 / block_bits, static_cast<double>(hashes));
+    double total = 0.0;
+    for (size_t i = 0; i < 4 * average + 50; ++i)
+    {
+        if (i > 0)
+        {
+            probability *= average / i;
+            bit_clear *= step;
+        }
+        total += probability * std::pow(1.0 - bit_clear, static_cast<double>(hashes));
+    }
+    return total;
+}
+
+// The high half of the hash picks the block (multiply-shift instead of a modulo), the low half picks the bits
+size_t BloomFilter::blockOf(uint64_t hash) const
+{
+    return static_cast<size_t>(((hash >> 32) * block_count) >> 32);
+}
+
+// The bits of a key within its block : the top bits of a multiplicative sequence started from the whole hash.
+// (Double hashing on 9-bit slices gave only 2^17 different patterns, and at low rates probes matched a key's pattern
+// far more often than the rate.)
+uint64_t BloomFilter::firstBits(uint64_t hash)
+{
+    return hash * 0x9E3779B97F4A7C15ull;
+}
+
+uint64_t BloomFilter::nextBits(uint64_t bit_source)
+{
+    return bit_source * 0xD6E8FEB86659FD93ull + 1;
+}
+
+void BloomFilter::add(uint64_t hash)
+{
+    if (block_count == 0)
+    {
+        return;
+    }
+    uint64_t *block = &bits[blockOf(hash) * BLOCK_WORDS];
+    uint64_t bit_source = firstBits(hash);
+    for (unsigned i = 0; i < hash_count; ++i, bit_source = nextBits(bit_source))
+    {
+        uint32_t bit = static_cast<uint32_t>(bit_source >> 55); // the top 9 bits : 0 to 511
+        block[bit >> 6] |= uint64_t(1) << (bit & 63);
+    }
+}
+
+bool BloomFilter::mightContain(uint64_t hash) const
+{
+    if (block_count == 0)
+    {
+        return true;
+    }
+    const uint64_t *block = &bits[blockOf(hash) * BLOCK_WORDS];
+    uint64_t bit_source = firstBits(hash);
+    for (unsigned i = 0; i < hash_count; ++i, bit_source = nextBits(bit_source))
+    {
+        uint32_t bit = static_cast<uint32_t>(bit_source >> 55);
+        if ((block[bit >> 6] & (uint64_t(1) << (bit & 63))) == 0)
+        {
+            return false; // one missing bit is enough : the key was never added
+        }
+    }
+    return true;
+}
+
+void BloomFilter::clear()
+{
+    bits.assign(bits.size(), 0);
+}
+
+size_t BloomFilter::capacity() const
+{
+    return max_keys;
+}
+
+double BloomFilter::falsePositiveRate() const
+{
+    return rate;
+}
+
+size_t BloomFilter::bytes() const
+{
+    return bits.capacity() * sizeof(uint64_t);
+}
+
+MemoryUsage BloomFilter::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.addAllocation(bits.capacity() * sizeof(uint64_t), 0, bits.size() * sizeof(uint64_t));
+    return usage;
+}
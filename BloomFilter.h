@@ -0,0 +1,43 @@
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include "MemoryUsage.h"
+
+// Blocked Bloom filter over 64-bit hashes.
+// The filter is split into 512-bit blocks (one cache line) and every bit of a key lands in the same block,
+// so a lookup touches one block whatever the number of hash functions.
+// A "no" is always right, a "maybe" is wrong with about the configured false-positive rate
+// as long as no more than capacity() keys were added.
+class BloomFilter
+{
+public:
+    BloomFilter(); // an empty filter, mightContain() says "maybe" to everything
+    BloomFilter(size_t capacity, double false_positive_rate);
+
+    void add(uint64_t hash);
+    bool mightContain(uint64_t hash) const;
+    void clear();
+    size_t capacity() const;
+    double falsePositiveRate() const;
+    size_t bytes() const;
+    MemoryUsage memoryUsage() const;
+
+private:
+    static const size_t BLOCK_WORDS = 8; // 8 x 64 bits = 512 bits per block
+
+    std::vector<uint64_t> bits;
+    size_t block_count;
+    size_t max_keys;
+    double rate;
+    unsigned hash_count; // bits set per key
+
+    size_t blockOf(uint64_t hash) const;
+    static uint64_t firstBits(uint64_t hash);      // where the bit positions of a key come from
+    static uint64_t nextBits(uint64_t bit_source); // the next position
+    static double blockedRate(double bits_per_key, unsigned hashes); // expected false-positive rate at capacity
+};
+
+#endif // BLOOMFILTER_H
@@ -0,0 +1,281 @@
+#include "FrontCodedList.h"
+#include <stdexcept> // length_error
+#include <cstring>
+using namespace std;
+
+namespace
+{
+    // strcmp order for words that are not null terminated (bytes compared as unsigned char, like strcmp)
+    int compareBytes(const unsigned char *a, size_t a_length, const char *b, size_t b_length)
+    {
+        size_t n = a_length < b_length ? a_length : b_length;
+        int cmp = memcmp(a, b, n);
+        if (cmp != 0)
+        {
+            return cmp;
+        }
+        return a_length < b_length ? -1 : (a_length > b_length ? 1 : 0);
+    }
+}
+
+// Default constructor : an empty list
+FrontCodedList::FrontCodedList() : count(0) {}
+
+// Constructor : FrontCodedList packed(list); encodes the sorted list in one pass
+FrontCodedList::FrontCodedList(const WordList &words) : count(0)
+{
+    encode(words.begin(), words.end());
+}
+
+FrontCodedList::FrontCodedList(const UnrolledWordList &words) : count(0)
+{
+    encode(words.begin(), words.end());
+}
+
+template <class Iterator>
+void FrontCodedList::encode(Iterator first, Iterator last)
+{
+    const char *previous = nullptr;
+    size_t previous_length = 0;
+    for (Iterator it = first; it != last; ++it)
+    {
+        const char *word = it->c_str();
+        size_t word_length = it->length();
+        if (count % BLOCK_SIZE == 0) // restart point : store the word in full
+        {
+            if (data.size() > UINT32_MAX)
+            {
+                throw length_error("Category too large to compress.");
+            }
+            blocks.push_back(static_cast<uint32_t>(data.size()));
+            putVarint(word_length);
+            data.insert(data.end(), word, word + word_length);
+        }
+        else
+        {
+            size_t shared = 0;
+            while (shared < previous_length && shared < word_length && previous[shared] == word[shared])
+            {
+                ++shared;
+            }
+            putVarint(shared);
+            putVarint(word_length - shared);
+            data.insert(data.end(), word + shared, word + word_length);
+        }
+        previous = word;
+        previous_length = word_length;
+        ++count;
+    }
+    data.shrink_to_fit();
+    blocks.shrink_to_fit();
+}
+
+size_t FrontCodedList::length() const
+{
+    return count;
+}
+
+bool FrontCodedList::isEmpty() const
+{
+    return count == 0;
+}
+
+size_t FrontCodedList::bytes() const
+{
+    return data.capacity() + blocks.capacity() * sizeof(uint32_t);
+}
+
+MemoryUsage FrontCodedList::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.addAllocation(data.capacity(), data.size(), 0);
+    usage.addAllocation(blocks.capacity() * sizeof(uint32_t), 0, blocks.size() * sizeof(uint32_t));
+    return usage;
+}
+
+// LEB128 : 7 bits per byte, high bit set on every byte but the last
+void FrontCodedList::putVarint(size_t value)
+{
+    while (value >= 0x80)
+    {
+        data.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<unsigned char>(value));
+}
+
+size_t FrontCodedList::getVarint(const unsigned char *&p)
+{
+    size_t value = 0;
+    int shift = 0;
+    while (*p & 0x80)
+    {
+        value |= static_cast<size_t>(*p++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= static_cast<size_t>(*p++) << shift;
+    return value;
+}
+
+// Binary search over the block heads, which are stored in full and can be compared in place
+size_t FrontCodedList::findBlock(const char *key, size_t key_length, bool strict) const
+{
+    size_t low = 0;
+    size_t high = blocks.size();
+    while (high - low > 1)
+    {
+        size_t middle = low + (high - low) / 2;
+        const unsigned char *p = data.data() + blocks[middle];
+        size_t head_length = getVarint(p);
+        int cmp = compareBytes(p, head_length, key, key_length);
+        if (cmp < 0 || (cmp == 0 && !strict))
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// Exact lookup. Inside the block only the bytes past the common prefix are compared :
+// matched is how much of the previous (smaller) word equals the key, and a word sharing fewer bytes
+// than that with the previous word is already greater than the key.
+bool FrontCodedList::contains(const char *word, size_t word_length) const
+{
+    if (count == 0)
+    {
+        return false;
+    }
+    size_t block = findBlock(word, word_length, false);
+    const unsigned char *p = data.data() + blocks[block];
+    size_t head_length = getVarint(p);
+    int cmp = compareBytes(p, head_length, word, word_length);
+    if (cmp == 0)
+    {
+        return true;
+    }
+    if (cmp > 0) // only possible for block 0 : the key is smaller than every word
+    {
+        return false;
+    }
+    size_t matched = 0;
+    while (matched < head_length && matched < word_length && p[matched] == static_cast<unsigned char>(word[matched]))
+    {
+        ++matched;
+    }
+    p += head_length;
+
+    size_t end = (block + 1) * BLOCK_SIZE < count ? (block + 1) * BLOCK_SIZE : count;
+    for (size_t i = block * BLOCK_SIZE + 1; i < end; ++i)
+    {
+        size_t shared = getVarint(p);
+        size_t suffix_length = getVarint(p);
+        const unsigned char *suffix = p;
+        p += suffix_length;
+        if (shared < matched) // differs from the previous word before the key does, so it is greater
+        {
+            return false;
+        }
+        if (shared > matched) // same bytes as the previous word where the key differs, still smaller
+        {
+            continue;
+        }
+        size_t j = 0;
+        while (j < suffix_length && matched + j < word_length && suffix[j] == static_cast<unsigned char>(word[matched + j]))
+        {
+            ++j;
+        }
+        if (j == suffix_length && matched + j == word_length)
+        {
+            return true;
+        }
+        if (j < suffix_length && (matched + j == word_length || suffix[j] > static_cast<unsigned char>(word[matched + j])))
+        {
+            return false; // passed the key
+        }
+        matched += j;
+    }
+    return false;
+}
+
+bool FrontCodedList::contains(const Word &word) const
+{
+    return contains(word.c_str(), word.length());
+}
+
+// Cursor : FrontCodedList::Cursor cursor(packed); while (cursor.valid()) { ...; cursor.next(); }
+FrontCodedList::Cursor::Cursor(const FrontCodedList &list) : list(&list), index(0), offset(0)
+{
+    if (list.count > 0)
+    {
+        decode();
+    }
+}
+
+// Decode the word at index, whose encoding starts at offset, on top of the previous word
+void FrontCodedList::Cursor::decode()
+{
+    const unsigned char *p = list->data.data() + offset;
+    if (index % BLOCK_SIZE == 0)
+    {
+        size_t head_length = getVarint(p);
+        current.assign(reinterpret_cast<const char *>(p), head_length);
+        p += head_length;
+    }
+    else
+    {
+        size_t shared = getVarint(p);
+        size_t suffix_length = getVarint(p);
+        current.resize(shared);
+        current.append(reinterpret_cast<const char *>(p), suffix_length);
+        p += suffix_length;
+    }
+    offset = p - list->data.data();
+}
+
+bool FrontCodedList::Cursor::valid() const
+{
+    return index < list->count;
+}
+
+const char *FrontCodedList::Cursor::data() const
+{
+    return current.data();
+}
+
+size_t FrontCodedList::Cursor::length() const
+{
+    return current.size();
+}
+
+void FrontCodedList::Cursor::next()
+{
+    if (++index < list->count)
+    {
+        decode();
+    }
+}
+
+// Jump to the block that may hold key when it is past the current one, then walk forward to the first word that is not smaller
+// (strict search : with duplicates, copies of key can end the block before the one whose head equals key)
+void FrontCodedList::Cursor::seek(const char *key, size_t key_length)
+{
+    if (!valid() || compareBytes(reinterpret_cast<const unsigned char *>(current.data()), current.size(), key, key_length) >= 0)
+    {
+        return; // already at or past key : a cursor only moves forward
+    }
+    size_t block = list->findBlock(key, key_length, true);
+    if (block > index / BLOCK_SIZE) // key is in a later block : start from its head instead of walking there
+    {
+        index = block * BLOCK_SIZE;
+        offset = list->blocks[block];
+        decode();
+    }
+    while (valid() && compareBytes(reinterpret_cast<const unsigned char *>(current.data()), current.size(), key, key_length) < 0)
+    {
+        next();
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef FRONTCODEDLIST_H
+#define FRONTCODEDLIST_H
+
+#include "UnrolledWordList.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Read-only, compressed copy of a sorted WordList (or UnrolledWordList).
+// Words are cut into blocks of BLOCK_SIZE. The first word of a block (the restart point) is stored in full,
+// every other word only stores how many leading bytes it shares with the previous word and the bytes that differ :
+//   head  : varint length, bytes
+//   other : varint shared, varint suffix length, suffix bytes
+// All blocks live in one byte array, so a category costs one allocation instead of one node + one buffer per word.
+// Exact lookup binary searches the block heads, then walks at most one block without decoding any word.
+class FrontCodedList
+{
+public:
+    static const size_t BLOCK_SIZE = 16;
+
+    // Walks the words in sorted order, decoding each one into a buffer that is reused for the whole walk
+    class Cursor
+    {
+    private:
+        const FrontCodedList *list;
+        size_t index;        // position of the current word
+        size_t offset;       // where the next word's encoding starts in list->data
+        std::string current; // the decoded current word
+
+        void decode();
+
+    public:
+        explicit Cursor(const FrontCodedList &list); // positioned on the first word
+        bool valid() const;                          // false once past the last word
+        const char *data() const;
+        size_t length() const;
+        void next();
+        void seek(const char *key, size_t key_length); // forward to the first word >= key, never back
+    };
+
+    FrontCodedList();
+    explicit FrontCodedList(const WordList &words); // words must be sorted
+    explicit FrontCodedList(const UnrolledWordList &words);
+
+    size_t length() const;
+    bool isEmpty() const;
+    bool contains(const char *word, size_t word_length) const;
+    bool contains(const Word &word) const;
+    size_t bytes() const; // heap bytes used by the encoding and the block index
+    MemoryUsage memoryUsage() const; // the encoded words count as payload
+
+private:
+    std::vector<unsigned char> data;
+    std::vector<uint32_t> blocks; // offset of each block head in data
+    size_t count;
+
+    template <class Iterator>
+    void encode(Iterator first, Iterator last);
+    size_t findBlock(const char *key, size_t key_length, bool strict) const; // last block whose head is <= key (< key if strict), 0 if none
+    void putVarint(size_t value);
+    static size_t getVarint(const unsigned char *&p);
+};
+
+#endif // FRONTCODEDLIST_H
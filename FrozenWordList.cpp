@@ -0,0 +1,223 @@
+#include "FrozenWordList.h"
+#include <stdexcept> // length_error
+#include <cstring>
+using namespace std;
+
+// Default constructor : an empty list
+FrozenWordList::FrozenWordList()
+{
+    pointAtVectors();
+}
+
+// Constructor : FrozenWordList frozen(list); two passes, one to size the arrays, one to fill them
+FrozenWordList::FrozenWordList(const WordList &words)
+{
+    build(words.begin(), words.end(), words.occurrences()); // a counted word is stored once per occurrence
+}
+
+FrozenWordList::FrozenWordList(const UnrolledWordList &words)
+{
+    build(words.begin(), words.end(), words.occurrences());
+}
+
+// Copy constructor : a list owning its arrays is copied, a view only shares the mapping
+FrozenWordList::FrozenWordList(const FrozenWordList &other)
+    : blob(other.blob), starts(other.starts), lengths(other.lengths), firsts(other.firsts), mapping(other.mapping)
+{
+    pointAt(other);
+}
+
+FrozenWordList::FrozenWordList(FrozenWordList &&other) noexcept
+    : blob(move(other.blob)), starts(move(other.starts)), lengths(move(other.lengths)), firsts(move(other.firsts)), mapping(move(other.mapping))
+{
+    pointAt(other);
+    other.pointAtVectors(); // left empty
+}
+
+FrozenWordList &FrozenWordList::operator=(const FrozenWordList &other)
+{
+    if (this != &other)
+    {
+        blob = other.blob;
+        starts = other.starts;
+        lengths = other.lengths;
+        firsts = other.firsts;
+        mapping = other.mapping;
+        pointAt(other);
+    }
+    return *this;
+}
+
+FrozenWordList &FrozenWordList::operator=(FrozenWordList &&other) noexcept
+{
+    if (this != &other)
+    {
+        blob = move(other.blob);
+        starts = move(other.starts);
+        lengths = move(other.lengths);
+        firsts = move(other.firsts);
+        mapping = move(other.mapping);
+        pointAt(other);
+        other.blob.clear();
+        other.starts.clear();
+        other.lengths.clear();
+        other.firsts.clear();
+        other.pointAtVectors();
+    }
+    return *this;
+}
+
+FrozenWordList FrozenWordList::view(const char *blob, const uint32_t *starts, const uint32_t *lengths, const unsigned char *firsts,
+                                    size_t count, const shared_ptr<const void> &mapping)
+{
+    FrozenWordList list;
+    list.blob_data = blob;
+    list.starts_data = starts;
+    list.lengths_data = lengths;
+    list.firsts_data = firsts;
+    list.count = count;
+    list.mapping = mapping;
+    return list;
+}
+
+bool FrozenWordList::isView() const
+{
+    return mapping != nullptr;
+}
+
+void FrozenWordList::pointAtVectors()
+{
+    blob_data = blob.data();
+    starts_data = starts.data();
+    lengths_data = lengths.data();
+    firsts_data = firsts.data();
+    count = starts.size();
+}
+
+// Called once this list holds other's vectors or mapping : the pointers of a view are still other's
+void FrozenWordList::pointAt(const FrozenWordList &other)
+{
+    if (mapping == nullptr)
+    {
+        pointAtVectors();
+        return;
+    }
+    blob_data = other.blob_data;
+    starts_data = other.starts_data;
+    lengths_data = other.lengths_data;
+    firsts_data = other.firsts_data;
+    count = other.count;
+}
+
+template <class Iterator>
+void FrozenWordList::build(Iterator first, Iterator last, size_t count)
+{
+    size_t total = 0;
+    for (Iterator it = first; it != last; ++it)
+    {
+        total += it->length() + 1;
+    }
+    if (total > UINT32_MAX)
+    {
+        throw length_error("Category too large to freeze.");
+    }
+    blob.resize(total);
+    starts.reserve(count);
+    lengths.reserve(count);
+    firsts.reserve(count);
+    size_t offset = 0;
+    for (Iterator it = first; it != last; ++it)
+    {
+        size_t word_length = it->length();
+        memcpy(blob.data() + offset, it->c_str(), word_length + 1); // with its '\0'
+        starts.push_back(static_cast<uint32_t>(offset));
+        lengths.push_back(static_cast<uint32_t>(word_length));
+        firsts.push_back(static_cast<unsigned char>(it->c_str()[0]));
+        offset += word_length + 1;
+    }
+    pointAtVectors();
+}
+
+size_t FrozenWordList::length() const
+{
+    return count;
+}
+
+bool FrozenWordList::isEmpty() const
+{
+    return count == 0;
+}
+
+const char *FrozenWordList::data(size_t i) const
+{
+    return blob_data + starts_data[i];
+}
+
+size_t FrozenWordList::length(size_t i) const
+{
+    return lengths_data[i];
+}
+
+// A view counts nothing : the memory it reads is mapped and shared, not on this process's heap
+size_t FrozenWordList::bytes() const
+{
+    return blob.capacity() + (starts.capacity() + lengths.capacity()) * sizeof(uint32_t) + firsts.capacity();
+}
+
+MemoryUsage FrozenWordList::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.addAllocation(blob.capacity(), blob.size() - starts.size(), starts.size()); // the null characters are structure
+    usage.addAllocation(starts.capacity() * sizeof(uint32_t), 0, starts.size() * sizeof(uint32_t));
+    usage.addAllocation(lengths.capacity() * sizeof(uint32_t), 0, lengths.size() * sizeof(uint32_t));
+    usage.addAllocation(firsts.capacity(), 0, firsts.size());
+    return usage;
+}
+
+// strcmp order; the cached first byte answers without reading the blob unless the first bytes are equal
+int FrozenWordList::compareAt(size_t i, const char *key, size_t key_length) const
+{
+    unsigned char key_first = key_length > 0 ? static_cast<unsigned char>(key[0]) : 0;
+    if (firsts_data[i] != key_first)
+    {
+        return firsts_data[i] < key_first ? -1 : 1;
+    }
+    size_t n = lengths_data[i] < key_length ? lengths_data[i] : key_length;
+    int cmp = memcmp(blob_data + starts_data[i], key, n);
+    if (cmp != 0)
+    {
+        return cmp;
+    }
+    return lengths_data[i] < key_length ? -1 : (lengths_data[i] > key_length ? 1 : 0);
+}
+
+// Binary search over [from, length())
+size_t FrozenWordList::lowerBound(const char *key, size_t key_length, size_t from) const
+{
+    size_t low = from;
+    size_t high = count;
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (compareAt(middle, key, key_length) < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+bool FrozenWordList::contains(const char *word, size_t word_length) const
+{
+    size_t i = lowerBound(word, word_length);
+    return i < count && compareAt(i, word, word_length) == 0;
+}
+
+bool FrozenWordList::contains(const Word &word) const
+{
+    return contains(word.c_str(), word.length());
+}
@@ -0,0 +1,65 @@
+#ifndef FROZENWORDLIST_H
+#define FROZENWORDLIST_H
+
+#include "UnrolledWordList.h"
+#include <stdint.h>
+#include <memory> // shared_ptr
+#include <vector>
+
+// Read-only, columnar copy of a sorted WordList (or UnrolledWordList).
+// Every word is stored null terminated, one after the other, in a single character blob; parallel arrays hold
+// where each word starts, its length and its first byte :
+//   blob   : "cat\0cow\0dog\0"
+//   starts : 0 4 8      lengths : 3 3 3      firsts : 'c' 'c' 'd'
+// Lookup is a binary search over the arrays, the first bytes settle most comparisons without touching the blob.
+// Copying a frozen list copies four arrays, with no allocation per word.
+// A view (FrozenWordList::view) reads the four arrays from memory it does not own, e.g. a mapped SharedDictionary :
+// copying a view copies pointers, and the mapping stays alive while any view of it does.
+class FrozenWordList
+{
+private:
+    std::vector<char> blob;
+    std::vector<uint32_t> starts;
+    std::vector<uint32_t> lengths;
+    std::vector<unsigned char> firsts; // first byte of each word, 0 for an empty word
+
+    // where the four arrays are read from : the vectors above, or the memory of a view
+    const char *blob_data;
+    const uint32_t *starts_data;
+    const uint32_t *lengths_data;
+    const unsigned char *firsts_data;
+    size_t count;
+    std::shared_ptr<const void> mapping; // what a view reads from, nullptr when the list owns its arrays
+
+    void pointAtVectors();
+    void pointAt(const FrozenWordList &other); // other's memory if it is a view, else this list's own vectors
+    template <class Iterator>
+    void build(Iterator first, Iterator last, size_t count);
+    int compareAt(size_t i, const char *key, size_t key_length) const;
+
+public:
+    FrozenWordList();
+    explicit FrozenWordList(const WordList &words); // words must be sorted
+    explicit FrozenWordList(const UnrolledWordList &words);
+    FrozenWordList(const FrozenWordList &other);
+    FrozenWordList(FrozenWordList &&other) noexcept;
+    FrozenWordList &operator=(const FrozenWordList &other);
+    FrozenWordList &operator=(FrozenWordList &&other) noexcept;
+
+    // count words laid out like the arrays above, owned by mapping; nothing is copied
+    static FrozenWordList view(const char *blob, const uint32_t *starts, const uint32_t *lengths, const unsigned char *firsts,
+                               size_t count, const std::shared_ptr<const void> &mapping);
+    bool isView() const;
+
+    size_t length() const;
+    bool isEmpty() const;
+    const char *data(size_t i) const; // null terminated
+    size_t length(size_t i) const;
+    size_t lowerBound(const char *key, size_t key_length, size_t from = 0) const; // first word >= key at or after from
+    bool contains(const char *word, size_t word_length) const;
+    bool contains(const Word &word) const;
+    size_t bytes() const; // heap bytes used by the four arrays (none for a view)
+    MemoryUsage memoryUsage() const;
+};
+
+#endif // FROZENWORDLIST_H
@@ -0,0 +1,232 @@
+#include "LoadPipeline.h"
+#include "Trace.h"
+#include "Utf8.h"
+#include <stdexcept> // runtime_error
+#include <cerrno>
+#include <chrono>
+#include <cstring> // memchr, strerror
+#include <unistd.h> // read
+using namespace std;
+
+namespace
+{
+    // A stage with nothing to do yields for a while, then sleeps in short steps so a stage waiting on slow storage
+    // or a pipe does not keep a core busy
+    void backoff(unsigned &spins)
+    {
+        if (++spins < 64)
+        {
+            this_thread::yield();
+        }
+        else
+        {
+            this_thread::sleep_for(chrono::microseconds(100));
+        }
+    }
+}
+
+// Constructor : LoadPipeline pipeline(fd); the stages start reading at once
+LoadPipeline::LoadPipeline(int fd)
+    : fd(fd), chunks(CHUNK_QUEUE), batches(BATCH_QUEUE), cancelled(false), finished(false), invalid_lines(0)
+{
+    reader = thread(&LoadPipeline::readStage, this);
+    tokenizer = thread(&LoadPipeline::parseStage, this);
+}
+
+LoadPipeline::~LoadPipeline()
+{
+    cancelled.store(true, memory_order_relaxed);
+    reader.join();
+    tokenizer.join();
+}
+
+template <class T>
+bool LoadPipeline::push(SpscQueue<T> &queue, T &item)
+{
+    unsigned spins = 0;
+    while (!queue.tryPush(item))
+    {
+        if (cancelled.load(memory_order_relaxed))
+        {
+            return false;
+        }
+        backoff(spins);
+    }
+    return true;
+}
+
+template <class T>
+bool LoadPipeline::pop(SpscQueue<T> &queue, T &item)
+{
+    unsigned spins = 0;
+    while (!queue.tryPop(item))
+    {
+        if (cancelled.load(memory_order_relaxed))
+        {
+            return false;
+        }
+        backoff(spins);
+    }
+    return true;
+}
+
+// Reader stage : one read() per block, the last block pushed is an empty one (or one carrying the error)
+void LoadPipeline::readStage()
+{
+    while (true)
+    {
+        Chunk chunk;
+        chunk.data.reset(new char[CHUNK_SIZE]);
+        ssize_t n;
+        {
+            TRACE_SCOPE("read"); // load phase
+            n = read(fd, chunk.data.get(), CHUNK_SIZE);
+        }
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            chunk.data.reset();
+            chunk.error = string("Failed to read input: ") + strerror(errno);
+        }
+        else
+        {
+            chunk.length = static_cast<size_t>(n);
+        }
+        bool last = n <= 0;
+        if (!push(chunks, chunk) || last)
+        {
+            return;
+        }
+    }
+}
+
+// Tokenizer stage : cuts the blocks into lines, a line split across two blocks is gathered in pending
+void LoadPipeline::parseStage()
+{
+    string pending;
+    bool in_category = false; // lines before the first header are ignored
+    Batch words;
+    words.kind = Batch::WORDS;
+    Chunk chunk;
+    while (pop(chunks, chunk))
+    {
+        if (!chunk.error.empty() || chunk.length == 0)
+        {
+            if (chunk.error.empty() && !pending.empty() && !parseLine(pending.data(), pending.size(), in_category, words)) // last line had no '\n'
+            {
+                return;
+            }
+            if (!words.words.empty() && !push(batches, words))
+            {
+                return;
+            }
+            Batch end;
+            end.kind = chunk.error.empty() ? Batch::END : Batch::FAILED;
+            end.error = chunk.error;
+            push(batches, end);
+            return;
+        }
+        TRACE_SCOPE("parse"); // load phase
+        const char *p = chunk.data.get();
+        const char *stop = p + chunk.length;
+        while (p < stop)
+        {
+            const char *newline = static_cast<const char *>(memchr(p, '\n', stop - p));
+            if (newline == nullptr) // the rest of the line is in the next block
+            {
+                pending.append(p, stop - p);
+                break;
+            }
+            bool ok;
+            if (pending.empty())
+            {
+                ok = parseLine(p, newline - p, in_category, words);
+            }
+            else
+            {
+                pending.append(p, newline - p);
+                ok = parseLine(pending.data(), pending.size(), in_category, words);
+                pending.clear();
+            }
+            if (!ok)
+            {
+                return;
+            }
+            p = newline + 1;
+        }
+    }
+}
+
+// One line without its '\n' : a header sends the words so far and then itself, a word joins the batch
+bool LoadPipeline::parseLine(const char *line, size_t length, bool &in_category, Batch &words)
+{
+    if (length > 0 && line[length - 1] == '\r')
+    {
+        --length;
+    }
+    if (length == 0)
+    {
+        return true;
+    }
+    if (!utf8Valid(line, length))
+    {
+        ++invalid_lines;
+        return true;
+    }
+    if (line[0] == '#')
+    {
+        if (!words.words.empty())
+        {
+            if (!push(batches, words))
+            {
+                return false;
+            }
+            words.words.clear(); // moved-from
+        }
+        Batch header;
+        header.kind = Batch::HEADER;
+        header.name = Word(line + 1, length - 1);
+        in_category = true;
+        return push(batches, header);
+    }
+    if (!in_category)
+    {
+        return true;
+    }
+    words.words.push_back(Word(line, length));
+    if (words.words.size() < BATCH_WORDS)
+    {
+        return true;
+    }
+    bool ok = push(batches, words);
+    words.words.clear();
+    words.words.reserve(BATCH_WORDS);
+    return ok;
+}
+
+// Builder side
+bool LoadPipeline::next(Batch &batch)
+{
+    if (finished || !pop(batches, batch))
+    {
+        return false;
+    }
+    if (batch.kind == Batch::END || batch.kind == Batch::FAILED)
+    {
+        finished = true;
+        if (batch.kind == Batch::FAILED)
+        {
+            throw runtime_error(batch.error);
+        }
+        return false;
+    }
+    return true;
+}
+
+size_t LoadPipeline::skipped() const
+{
+    return invalid_lines;
+}
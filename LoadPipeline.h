@@ -0,0 +1,79 @@
+#ifndef LOADPIPELINE_H
+#define LOADPIPELINE_H
+
+#include "SpscQueue.h"
+#include "Word.h"
+#include <atomic>
+#include <cstddef>
+#include <memory> // unique_ptr
+#include <string>
+#include <thread>
+#include <vector>
+
+// Staged loading of a vocabulary file ("#category" lines, then one word per line) :
+//   reader thread    : read()s the input in CHUNK_SIZE blocks, up to CHUNK_QUEUE blocks ahead of the tokenizer
+//   tokenizer thread : splits the blocks into lines and hands out category headers and batches of words
+//   builder          : the caller, taking batches with next() and building the categories
+// The stages are joined by bounded lock-free queues, so reading, parsing and building overlap and a load takes about
+// as long as its slowest stage. Lines that are empty are skipped, lines that are not valid UTF-8 are skipped and counted.
+// LoadPipeline pipeline(fd); LoadPipeline::Batch batch; while (pipeline.next(batch)) { ... }
+class LoadPipeline
+{
+public:
+    static const size_t CHUNK_SIZE = 64 * 1024;
+    static const size_t CHUNK_QUEUE = 16; // blocks read ahead
+    static const size_t BATCH_WORDS = 4096;
+    static const size_t BATCH_QUEUE = 16;
+
+    struct Batch
+    {
+        enum Kind
+        {
+            HEADER, // a "#name" line : name is the new category
+            WORDS,  // words of the current category, in file order
+            END,    // the input is exhausted
+            FAILED  // reading failed : error says why
+        };
+        Kind kind;
+        Word name;
+        std::vector<Word> words;
+        std::string error;
+        Batch() : kind(END) {}
+    };
+
+    explicit LoadPipeline(int fd); // starts the reader and tokenizer threads; the fd stays owned by the caller
+    LoadPipeline(const LoadPipeline &) = delete;
+    LoadPipeline &operator=(const LoadPipeline &) = delete;
+    ~LoadPipeline(); // stops the threads early if the input was not read to the end (waits for a read() in progress)
+
+    bool next(Batch &batch); // HEADER or WORDS batch, false at the end; throws runtime_error if reading failed
+    size_t skipped() const;  // lines that were not valid UTF-8, complete once next() returned false
+
+private:
+    struct Chunk
+    {
+        std::unique_ptr<char[]> data; // CHUNK_SIZE bytes, length of them read
+        size_t length;                // 0 at the end of input
+        std::string error;            // set instead when reading failed
+        Chunk() : length(0) {}
+    };
+
+    int fd;
+    SpscQueue<Chunk> chunks;   // reader -> tokenizer
+    SpscQueue<Batch> batches;  // tokenizer -> builder
+    std::atomic<bool> cancelled;
+    bool finished;
+    size_t invalid_lines; // written by the tokenizer, read once it has sent END
+    std::thread reader;
+    std::thread tokenizer;
+
+    void readStage();
+    void parseStage();
+    bool parseLine(const char *line, size_t length, bool &in_category, Batch &words); // false if cancelled
+    template <class T>
+    bool push(SpscQueue<T> &queue, T &item); // waits while the queue is full, false if cancelled
+    template <class T>
+    bool pop(SpscQueue<T> &queue, T &item);  // waits while the queue is empty, false if cancelled
+};
+
+#endif // LOADPIPELINE_H
@@ -0,0 +1,62 @@
+#ifndef MEMORYUSAGE_H
+#define MEMORYUSAGE_H
+
+#include <cstddef>
+#include <iostream>
+
+// Heap footprint of a structure, split by what the bytes are for :
+//   payload   : the characters of words and category names
+//   allocator : malloc headers and rounding (modelled on glibc : 8-byte header, 16-byte steps, 32-byte minimum)
+//   structure : node links, Word objects, terminators, offset arrays, hash tables, filters
+//   unused    : capacity allocated but not in use (spare slots of arrays and blocks, vector reserve)
+// Only heap bytes are counted : an object reports what it allocates, not its own sizeof, which its owner counts.
+struct MemoryUsage
+{
+    size_t payload;
+    size_t allocator;
+    size_t structure;
+    size_t unused;
+
+    MemoryUsage() : payload(0), allocator(0), structure(0), unused(0) {}
+
+    // Bytes malloc really uses for a request of requested bytes
+    static size_t allocationSize(size_t requested)
+    {
+        if (requested == 0)
+        {
+            return 0;
+        }
+        size_t chunk = (requested + 8 + 15) & ~static_cast<size_t>(15);
+        return chunk < 32 ? 32 : chunk;
+    }
+
+    // One allocation of requested bytes holding payload_bytes of payload and structure_bytes of structure, the rest is unused
+    void addAllocation(size_t requested, size_t payload_bytes, size_t structure_bytes)
+    {
+        allocator += allocationSize(requested) - requested;
+        payload += payload_bytes;
+        structure += structure_bytes;
+        unused += requested - payload_bytes - structure_bytes;
+    }
+
+    size_t total() const { return payload + allocator + structure + unused; }
+    size_t overhead() const { return total() - payload; }
+
+    MemoryUsage &operator+=(const MemoryUsage &other)
+    {
+        payload += other.payload;
+        allocator += other.allocator;
+        structure += other.structure;
+        unused += other.unused;
+        return *this;
+    }
+
+    // payload 120, allocator 56, structure 300, unused 40, total 516 bytes
+    void print(std::ostream &os) const
+    {
+        os << "payload " << payload << ", allocator " << allocator << ", structure " << structure
+           << ", unused " << unused << ", total " << total() << " bytes";
+    }
+};
+
+#endif // MEMORYUSAGE_H
@@ -0,0 +1,84 @@
+#include "MergedWordCursor.h"
+#include "WordCatVec.h"
+#include <algorithm> // make_heap, push_heap, pop_heap
+#include <cstring>
+#include <functional> // bind
+using namespace std;
+
+// Constructor : MergedWordCursor cursor(vec, prefix); every category seeks to its first word >= prefix
+MergedWordCursor::MergedWordCursor(const WordCatVec &categories, const char *prefix) : prefix(prefix)
+{
+    cursors.reserve(categories.length()); // no reallocation, the cursors are never moved once the heap refers to them
+    for (size_t i = 0; i < categories.length(); ++i)
+    {
+        const WordCat &category = categories.at(i);
+        WordCat::Cursor cursor(category);
+        if (!this->prefix.empty())
+        {
+            cursor.seek(this->prefix.data(), this->prefix.size());
+        }
+        if (matches(cursor))
+        {
+            heap.push_back(cursors.size());
+            cursors.push_back(cursor);
+            owners.push_back(&category);
+        }
+    }
+    make_heap(heap.begin(), heap.end(), bind(&MergedWordCursor::greater, this, placeholders::_1, placeholders::_2));
+}
+
+bool MergedWordCursor::matches(const WordCat::Cursor &cursor) const
+{
+    return cursor.valid() && cursor.length() >= prefix.size() && memcmp(cursor.data(), prefix.data(), prefix.size()) == 0;
+}
+
+// strcmp order on the current words, then category order so equal words keep the order of the categories
+bool MergedWordCursor::greater(size_t a, size_t b) const
+{
+    const WordCat::Cursor &x = cursors[a];
+    const WordCat::Cursor &y = cursors[b];
+    size_t n = x.length() < y.length() ? x.length() : y.length();
+    int cmp = memcmp(x.data(), y.data(), n);
+    if (cmp == 0)
+    {
+        cmp = x.length() < y.length() ? -1 : (x.length() > y.length() ? 1 : 0);
+    }
+    return cmp != 0 ? cmp > 0 : a > b;
+}
+
+bool MergedWordCursor::valid() const
+{
+    return !heap.empty();
+}
+
+const char *MergedWordCursor::data() const
+{
+    return cursors[heap.front()].data();
+}
+
+size_t MergedWordCursor::length() const
+{
+    return cursors[heap.front()].length();
+}
+
+const WordCat &MergedWordCursor::category() const
+{
+    return *owners[heap.front()];
+}
+
+// Take the top cursor out, move it on, and put it back unless its category has no more words in range
+void MergedWordCursor::next()
+{
+    auto order = bind(&MergedWordCursor::greater, this, placeholders::_1, placeholders::_2);
+    pop_heap(heap.begin(), heap.end(), order);
+    WordCat::Cursor &cursor = cursors[heap.back()];
+    cursor.next();
+    if (matches(cursor))
+    {
+        push_heap(heap.begin(), heap.end(), order);
+    }
+    else
+    {
+        heap.pop_back();
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef MERGEDWORDCURSOR_H
+#define MERGEDWORDCURSOR_H
+
+#include "WordCat.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class WordCatVec;
+
+// Walks the words of every category together in one sorted order, each word with the category it came from.
+// Every category is already sorted, so one WordCat::Cursor per category is kept in a min-heap on its current word :
+// the top is the next word overall, and moving past it costs O(log k) for k categories. Nothing is copied or sorted,
+// and stopping after the first N words costs O(k + N log k) (plus one seek per category for a prefix).
+// Equal words come out in category order.
+// for (MergedWordCursor cursor(vec, "s"); cursor.valid() && shown < 10; cursor.next()) { cursor.data(), cursor.category() }
+// no category may be edited, added or removed while a cursor is in use
+class MergedWordCursor
+{
+private:
+    std::vector<WordCat::Cursor> cursors; // one per category that still has words to give
+    std::vector<const WordCat *> owners;  // owners[i] is the category of cursors[i]
+    std::vector<size_t> heap;             // indexes into cursors, smallest current word on top
+    std::string prefix;
+
+    bool matches(const WordCat::Cursor &cursor) const; // valid and still inside the prefix range
+    bool greater(size_t a, size_t b) const;           // heap order : true when cursors[a] comes after cursors[b]
+
+public:
+    explicit MergedWordCursor(const WordCatVec &categories, const char *prefix = ""); // deferred categories are read first
+
+    bool valid() const;
+    const char *data() const; // not null terminated when the category is compressed
+    size_t length() const;
+    const WordCat &category() const;
+    void next();
+};
+
+#endif // MERGEDWORDCURSOR_H
@@ -0,0 +1,67 @@
+#include "QueryCache.h"
+using namespace std;
+
+// Constructor : QueryCache cache(256); holds at most capacity results
+QueryCache::QueryCache(size_t capacity) : uncached(), capacity(capacity), hit_count(0), miss_count(0) {}
+
+QueryCache::Entry &QueryCache::entryFor(const string &key, bool &found)
+{
+    if (capacity == 0)
+    {
+        found = false;
+        return uncached;
+    }
+    unordered_map<string, list<Entry>::iterator>::iterator place = index.find(key);
+    found = place != index.end();
+    if (found)
+    {
+        entries.splice(entries.begin(), entries, place->second); // most recently used, iterators stay valid
+        return entries.front();
+    }
+    if (entries.size() == capacity) // evict the least recently used
+    {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+    entries.push_front(Entry());
+    entries.front().key = key;
+    entries.front().stamp = 0;
+    index[key] = entries.begin();
+    return entries.front();
+}
+
+void QueryCache::clear()
+{
+    entries.clear();
+    index.clear();
+}
+
+void QueryCache::setCapacity(size_t new_capacity)
+{
+    capacity = new_capacity;
+    while (entries.size() > capacity)
+    {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+size_t QueryCache::length() const
+{
+    return entries.size();
+}
+
+size_t QueryCache::maxLength() const
+{
+    return capacity;
+}
+
+size_t QueryCache::hits() const
+{
+    return hit_count;
+}
+
+size_t QueryCache::misses() const
+{
+    return miss_count;
+}
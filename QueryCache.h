@@ -0,0 +1,110 @@
+#ifndef QUERYCACHE_H
+#define QUERYCACHE_H
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Bounded LRU cache of query results, keyed by the query and its argument, e.g. "S\tcat".
+// A result is a list of strings (category names, words...) rather than printed text, so the menu and the server
+// format the same cached result each their own way.
+// A query over the categories is cached as one part per category, each with the version of the category it was
+// computed from : after an edit only the parts of the edited categories are computed again, the others are reused.
+// Every edit anywhere also moves a global stamp; while the stamp has not moved and the number of categories is the same
+// (removing the last category moves no other one), a lookup returns the entry without looking at a single version,
+// so a hit costs one hash lookup and a splice, whatever the number of categories.
+// Source tells get() about the categories : unsigned long stamp() const; size_t count() const;
+//                                           unsigned long version(size_t i) const; void compute(size_t i, QueryCache::Result &part) const;
+// QueryCache cache(256); const QueryCache::Result &result = cache.get(key, source); // valid until the next get
+class QueryCache
+{
+public:
+    typedef std::vector<std::string> Result;
+
+    explicit QueryCache(size_t capacity = 256);
+
+    template <class Source>
+    const Result &get(const std::string &key, const Source &source);
+    void clear();                          // the counters are kept
+    void setCapacity(size_t new_capacity); // 0 turns caching off, extra entries are evicted
+    size_t length() const;
+    size_t maxLength() const;
+    size_t hits() const;   // answered without computing any part
+    size_t misses() const; // at least one part computed
+
+private:
+    struct Entry
+    {
+        std::string key;
+        unsigned long stamp;                 // when the parts were last checked
+        std::vector<unsigned long> versions; // of each category when its part was computed
+        std::vector<Result> parts;           // what each category contributed
+        Result result;                       // the parts one after the other
+    };
+
+    std::list<Entry> entries; // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    Entry uncached; // where get() works while the capacity is 0
+    size_t capacity;
+    size_t hit_count;
+    size_t miss_count;
+
+    Entry &entryFor(const std::string &key, bool &found); // the entry of key, most recently used; a new empty one if there was none
+};
+
+template <class Source>
+const QueryCache::Result &QueryCache::get(const std::string &key, const Source &source)
+{
+    bool found;
+    Entry &entry = entryFor(key, found);
+    size_t count = source.count();
+    if (found && entry.stamp == source.stamp() && entry.parts.size() == count) // nothing edited, and no category dropped off the end
+    {
+        ++hit_count;
+        return entry.result;
+    }
+    bool computed = false;
+    if (!found || entry.parts.size() != count) // categories added or removed : the positions moved, every part goes
+    {
+        entry.parts.assign(count, Result());
+        entry.versions.assign(count, 0);
+        for (size_t i = 0; i < count; ++i)
+        {
+            source.compute(i, entry.parts[i]);
+            entry.versions[i] = source.version(i);
+        }
+        computed = true;
+    }
+    else
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (entry.versions[i] != source.version(i)) // versions are never shared, so this is another category or an edited one
+            {
+                entry.parts[i].clear();
+                source.compute(i, entry.parts[i]);
+                entry.versions[i] = source.version(i);
+                computed = true;
+            }
+        }
+    }
+    if (computed)
+    {
+        entry.result.clear();
+        for (size_t i = 0; i < count; ++i)
+        {
+            entry.result.insert(entry.result.end(), entry.parts[i].begin(), entry.parts[i].end());
+        }
+        ++miss_count;
+    }
+    else
+    {
+        ++hit_count;
+    }
+    entry.stamp = source.stamp(); // taken after computing : reading a deferred category is an edit too
+    return entry.result;
+}
+
+#endif // QUERYCACHE_H
@@ -0,0 +1,306 @@
+#include "SharedDictionary.h"
+#include "WordCatVec.h"
+#include "WordStats.h"
+#include "Trace.h"
+#include <stdexcept> // runtime_error
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h> // mmap
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+namespace
+{
+    const char MAGIC[8] = {'A', '1', 'S', 'H', 'M', '0', '0', '3'};
+
+    // Every field is 8 bytes, so there is no padding for two builds to disagree on
+    struct Header
+    {
+        char magic[8];
+        uint64_t size;
+        uint64_t categories;
+        uint64_t checksum; // of the category table
+    };
+
+    struct Entry
+    {
+        uint64_t name;
+        uint64_t name_length;
+        uint64_t words;
+        uint64_t blob;
+        uint64_t blob_size;
+        uint64_t starts;
+        uint64_t lengths;
+        uint64_t firsts;
+        uint64_t checksum;                 // of the starts, lengths and firsts arrays
+        uint64_t stats[WordStats::FIELDS]; // see WordStats::save
+    };
+
+    void throwErrno(const string &what)
+    {
+        throw runtime_error(what + ": " + strerror(errno));
+    }
+
+    uint64_t align8(uint64_t offset)
+    {
+        return (offset + 7) & ~static_cast<uint64_t>(7);
+    }
+
+    // offset + length <= size, without overflowing
+    bool fits(uint64_t offset, uint64_t length, uint64_t size)
+    {
+        return offset <= size && length <= size - offset;
+    }
+
+    Entry entryAt(const char *base, size_t n)
+    {
+        Entry entry;
+        memcpy(&entry, base + sizeof(Header) + n * sizeof(Entry), sizeof(entry));
+        return entry;
+    }
+
+    uint64_t tableChecksum(const char *base, uint64_t categories)
+    {
+        return Word::hash(base + sizeof(Header), categories * sizeof(Entry));
+    }
+
+    // The arrays every lookup reads an offset from; the blob is left out, a damaged character cannot send a read astray
+    uint64_t arraysChecksum(const char *base, const Entry &entry)
+    {
+        uint64_t h = Word::hash(base + entry.starts, entry.words * sizeof(uint32_t));
+        h = h * 31 + Word::hash(base + entry.lengths, entry.words * sizeof(uint32_t));
+        return h * 31 + Word::hash(base + entry.firsts, entry.words);
+    }
+}
+
+SharedDictionary::SharedDictionary(const char *base, size_t size) : base(base), size(size) {}
+
+SharedDictionary::~SharedDictionary()
+{
+    munmap(const_cast<char *>(base), size);
+}
+
+// Two walks over every category : one to lay the file out and count the stats, one to fill it in place through a writable mapping
+void SharedDictionary::publish(const WordCatVec &vocabulary, const char *filename)
+{
+    TRACE_SCOPE("SharedDictionary::publish");
+    size_t count = vocabulary.length();
+    vector<Entry> entries(count);
+    uint64_t total = sizeof(Header) + count * sizeof(Entry);
+    for (size_t n = 0; n < count; ++n)
+    {
+        const WordCat &category = vocabulary.at(n);
+        Entry &entry = entries[n];
+        entry.words = 0;
+        entry.blob_size = 0;
+        WordStats stats; // of the words as the cursor hands them out, which is what attach will see
+        for (WordCat::Cursor cursor(category); cursor.valid(); cursor.next())
+        {
+            ++entry.words;
+            entry.blob_size += cursor.length() + 1; // with its '\0'
+            stats.add(cursor.data(), cursor.length());
+        }
+        stats.save(entry.stats);
+        if (entry.blob_size > UINT32_MAX)
+        {
+            throw runtime_error("Category too large to publish.");
+        }
+        entry.name_length = category.getName().length();
+        entry.name = total;
+        total = align8(total + entry.name_length + 1);
+        entry.blob = total;
+        total = align8(total + entry.blob_size);
+        entry.starts = total;
+        total = align8(total + entry.words * sizeof(uint32_t));
+        entry.lengths = total;
+        total = align8(total + entry.words * sizeof(uint32_t));
+        entry.firsts = total;
+        total = align8(total + entry.words);
+    }
+
+    string temporary = string(filename) + ".tmp";
+    int fd = open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd == -1)
+    {
+        throwErrno(temporary);
+    }
+    if (ftruncate(fd, total) != 0)
+    {
+        close(fd);
+        unlink(temporary.c_str());
+        throwErrno(temporary);
+    }
+    void *mapped = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd); // the mapping keeps the file open
+    if (mapped == MAP_FAILED)
+    {
+        unlink(temporary.c_str());
+        throwErrno(temporary);
+    }
+    char *out = static_cast<char *>(mapped); // ftruncate zero-filled it, so the alignment gaps are zeros
+
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.size = total;
+    header.categories = count;
+    for (size_t n = 0; n < count; ++n)
+    {
+        const WordCat &category = vocabulary.at(n);
+        Entry &entry = entries[n];
+        memcpy(out + entry.name, category.c_str(), entry.name_length + 1);
+        uint32_t *starts = reinterpret_cast<uint32_t *>(out + entry.starts);
+        uint32_t *lengths = reinterpret_cast<uint32_t *>(out + entry.lengths);
+        unsigned char *firsts = reinterpret_cast<unsigned char *>(out + entry.firsts);
+        size_t offset = 0;
+        size_t i = 0;
+        for (WordCat::Cursor cursor(category); cursor.valid(); cursor.next(), ++i)
+        {
+            size_t word_length = cursor.length();
+            memcpy(out + entry.blob + offset, cursor.data(), word_length); // the '\0' is already there
+            starts[i] = static_cast<uint32_t>(offset);
+            lengths[i] = static_cast<uint32_t>(word_length);
+            firsts[i] = word_length > 0 ? static_cast<unsigned char>(cursor.data()[0]) : 0;
+            offset += word_length + 1;
+        }
+        entry.checksum = arraysChecksum(out, entry);
+    }
+    if (count > 0) // the table goes in last, once the checksums of the arrays are known
+    {
+        memcpy(out + sizeof(Header), entries.data(), count * sizeof(Entry));
+    }
+    header.checksum = tableChecksum(out, count);
+    memcpy(out, &header, sizeof(header));
+    munmap(mapped, total);
+    if (rename(temporary.c_str(), filename) != 0)
+    {
+        unlink(temporary.c_str());
+        throwErrno(filename);
+    }
+}
+
+// Maps the file read-only; nothing is copied, the words are only read when a query needs them
+shared_ptr<const SharedDictionary> SharedDictionary::attach(const char *filename)
+{
+    TRACE_SCOPE("SharedDictionary::attach");
+    int fd = open(filename, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        throwErrno(filename);
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0)
+    {
+        close(fd);
+        throwErrno(filename);
+    }
+    if (status.st_size < static_cast<off_t>(sizeof(Header)))
+    {
+        close(fd);
+        throw runtime_error(string(filename) + ": not a shared dictionary");
+    }
+    size_t size = status.st_size;
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        throwErrno(filename);
+    }
+    shared_ptr<const SharedDictionary> dictionary(new SharedDictionary(static_cast<const char *>(mapped), size)); // unmaps if validate throws
+    try
+    {
+        dictionary->validate();
+    }
+    catch (const runtime_error &e)
+    {
+        throw runtime_error(string(filename) + ": " + e.what());
+    }
+    return dictionary;
+}
+
+// A damaged or hostile file must not make a query read outside the mapping. The checksum catches a damaged table,
+// every array must lie inside the mapping, and every word must end inside its blob, which ends with a '\0'.
+// Only the starts, lengths and firsts arrays are read, one pass each, never the blob : the words are not counted
+// either, their stats are in the table.
+void SharedDictionary::validate() const
+{
+    Header header;
+    memcpy(&header, base, sizeof(header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.size != size)
+    {
+        throw runtime_error("not a shared dictionary");
+    }
+    if (header.categories > (size - sizeof(Header)) / sizeof(Entry))
+    {
+        throw runtime_error("category table out of bounds");
+    }
+    if (tableChecksum(base, header.categories) != header.checksum)
+    {
+        throw runtime_error("category table damaged");
+    }
+    for (size_t n = 0; n < header.categories; ++n)
+    {
+        Entry entry = entryAt(base, n);
+        if (!fits(entry.name, entry.name_length, size - 1) || base[entry.name + entry.name_length] != '\0' ||
+            !fits(entry.blob, entry.blob_size, size) || entry.blob_size > UINT32_MAX ||
+            entry.starts % sizeof(uint32_t) != 0 || entry.words > size / sizeof(uint32_t) ||
+            !fits(entry.starts, entry.words * sizeof(uint32_t), size) ||
+            entry.lengths % sizeof(uint32_t) != 0 || !fits(entry.lengths, entry.words * sizeof(uint32_t), size) ||
+            !fits(entry.firsts, entry.words, size))
+        {
+            throw runtime_error("category out of bounds");
+        }
+        if (entry.words == 0)
+        {
+            continue;
+        }
+        if (entry.blob_size == 0 || base[entry.blob + entry.blob_size - 1] != '\0') // reading a word to its '\0' stops in the blob
+        {
+            throw runtime_error("category out of bounds");
+        }
+        const uint32_t *starts = reinterpret_cast<const uint32_t *>(base + entry.starts);
+        const uint32_t *lengths = reinterpret_cast<const uint32_t *>(base + entry.lengths);
+        for (size_t i = 0; i < entry.words; ++i)
+        {
+            if (static_cast<uint64_t>(starts[i]) + lengths[i] >= entry.blob_size)
+            {
+                throw runtime_error("word out of bounds");
+            }
+        }
+        if (arraysChecksum(base, entry) != entry.checksum)
+        {
+            throw runtime_error("category damaged");
+        }
+    }
+}
+
+size_t SharedDictionary::length() const
+{
+    Header header;
+    memcpy(&header, base, sizeof(header));
+    return header.categories;
+}
+
+WordStats SharedDictionary::stats(size_t n) const
+{
+    Entry entry = entryAt(base, n);
+    WordStats stats;
+    stats.restore(entry.stats);
+    return stats;
+}
+
+Word SharedDictionary::name(size_t n) const
+{
+    Entry entry = entryAt(base, n);
+    return Word(base + entry.name, entry.name_length);
+}
+
+FrozenWordList SharedDictionary::words(size_t n) const
+{
+    Entry entry = entryAt(base, n);
+    return FrozenWordList::view(base + entry.blob, reinterpret_cast<const uint32_t *>(base + entry.starts),
+                                reinterpret_cast<const uint32_t *>(base + entry.lengths),
+                                reinterpret_cast<const unsigned char *>(base + entry.firsts), entry.words, shared_from_this());
+}
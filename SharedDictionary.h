@@ -0,0 +1,46 @@
+#ifndef SHAREDDICTIONARY_H
+#define SHAREDDICTIONARY_H
+
+#include "FrozenWordList.h"
+#include "Word.h"
+#include <memory> // shared_ptr, enable_shared_from_this
+#include <stdint.h>
+
+class WordCatVec;
+class WordStats;
+
+// Read-only vocabulary in one file that many processes map at once : publish() writes the categories of a WordCatVec
+// in the frozen layout (see FrozenWordList), attach() maps the file and hands out views of it, so N processes on a host
+// share one physical copy and a new process only pays for mmap. Put the file under /dev/shm to keep it in memory.
+// Everything is found by offset from the start of the file, never by pointer, so each process may map it anywhere :
+//   header     : "A1SHM003", file size (8), category count (8), checksum of the category table (8)
+//   categories : per category, name offset, name length, word count, blob offset, blob size, starts, lengths, firsts,
+//                checksum of the starts, lengths and firsts arrays, then its WordStats counters (WordStats::FIELDS) (8 each)
+//   data       : per category its null terminated name, then its blob, starts, lengths and firsts arrays, each 8-byte aligned
+// Integers are in host byte order. The file is written next to its final name and renamed, so a process attaching
+// while it is republished sees either the old dictionary or the new one.
+// Attaching checks the table and the offset arrays (the stats are stored, not counted), it never reads the words.
+class SharedDictionary : public std::enable_shared_from_this<SharedDictionary>
+{
+private:
+    const char *base; // the mapping
+    size_t size;
+
+    SharedDictionary(const char *base, size_t size);
+    void validate() const; // throws runtime_error unless the checksums match and every array and every word lies inside the mapping
+
+public:
+    SharedDictionary(const SharedDictionary &) = delete;
+    SharedDictionary &operator=(const SharedDictionary &) = delete;
+    ~SharedDictionary(); // unmaps the file
+
+    static void publish(const WordCatVec &vocabulary, const char *filename); // throws runtime_error
+    static std::shared_ptr<const SharedDictionary> attach(const char *filename); // throws runtime_error
+
+    size_t length() const; // number of categories
+    Word name(size_t n) const;
+    FrozenWordList words(size_t n) const; // a view of the mapping, which stays mapped while the view lives
+    WordStats stats(size_t n) const;      // as published, the words are not read
+};
+
+#endif // SHAREDDICTIONARY_H
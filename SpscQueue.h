@@ -0,0 +1,65 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility> // move
+#include <vector>
+
+// Bounded queue between exactly one producer thread and one consumer thread, with no lock.
+// The producer only writes tail and the consumer only writes head; each publishes with a release store, so the
+// slot it filled (or emptied) is visible to the other side before the index is. tryPush / tryPop never wait :
+// a caller that has to wait decides how (see LoadPipeline).
+// SpscQueue<Chunk> queue(8); producer : queue.tryPush(chunk); consumer : queue.tryPop(chunk);
+template <class T>
+class SpscQueue
+{
+private:
+    std::vector<T> slots;
+    size_t mask;              // slots.size() - 1, the size is a power of two
+    std::atomic<size_t> head; // next slot to pop, written by the consumer
+    char padding[64];         // keeps head and tail on different cache lines, the two threads do not share one
+    std::atomic<size_t> tail; // next slot to push, written by the producer
+
+public:
+    explicit SpscQueue(size_t capacity) : head(0), tail(0)
+    {
+        size_t size = 1;
+        while (size < capacity)
+        {
+            size *= 2;
+        }
+        slots.resize(size);
+        mask = size - 1;
+    }
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    // Producer side : false when the queue is full, item is left untouched then
+    bool tryPush(T &item)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == slots.size())
+        {
+            return false;
+        }
+        slots[t & mask] = std::move(item);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side : false when the queue is empty
+    bool tryPop(T &item)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        item = std::move(slots[h & mask]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+#endif // SPSCQUEUE_H
@@ -0,0 +1,124 @@
+// Build-time tool : turns a vocabulary file (the format WordCatVec::loadFromFile reads) into a header of
+// sorted constexpr WordView tables that WordCatVec::addStaticCategory can use with no startup cost.
+//
+//   g++ -std=c++11 StaticDictGen.cpp -o StaticDictGen
+//   ./StaticDictGen A1_input.txt A1_dictionary > A1_dictionary.h
+//
+// The header static_asserts that every table is sorted, so a hand edit that breaks the order does not compile.
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+struct Category
+{
+    string name;
+    vector<string> words;
+};
+
+// C++ string literal for any bytes : octal escapes for everything but plain printable ASCII
+static string literal(const string &text)
+{
+    string out = "\"";
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        unsigned char c = text[i];
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if (c >= 0x20 && c < 0x7F && c != '?') // '?' would risk trigraphs
+        {
+            out += c;
+        }
+        else
+        {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\%03o", c);
+            out += escaped;
+        }
+    }
+    return out + "\"";
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        cerr << "usage: " << argv[0] << " <vocabulary file> <table name>\n";
+        return 1;
+    }
+    ifstream in(argv[1]);
+    if (!in)
+    {
+        cerr << "Failed to open file.\n";
+        return 1;
+    }
+    string prefix = argv[2];
+    string guard = prefix;
+    for (size_t i = 0; i < guard.size(); ++i)
+    {
+        guard[i] = isalnum(static_cast<unsigned char>(guard[i])) ? toupper(static_cast<unsigned char>(guard[i])) : '_';
+    }
+
+    vector<Category> categories;
+    string line;
+    while (getline(in, line)) // same rules as WordCatVec::loadFromFd
+    {
+        if (!line.empty() && line[line.size() - 1] == '\r')
+        {
+            line.erase(line.size() - 1);
+        }
+        if (line.empty())
+        {
+            continue;
+        }
+        if (line[0] == '#')
+        {
+            categories.push_back(Category());
+            categories.back().name = line.substr(1);
+        }
+        else if (!categories.empty())
+        {
+            categories.back().words.push_back(line);
+        }
+    }
+
+    cout << "// Generated by StaticDictGen from " << argv[1] << ", do not edit.\n";
+    cout << "#ifndef " << guard << "_H\n#define " << guard << "_H\n\n#include \"WordView.h\"\n\n";
+    for (size_t c = 0; c < categories.size(); ++c)
+    {
+        vector<string> &words = categories[c].words;
+        sort(words.begin(), words.end()); // std::string compares bytes as unsigned char, the same order as strcmp
+        string table = prefix + "_words_" + to_string(c);
+        cout << "static constexpr WordView " << table << "[] = {\n";
+        for (size_t i = 0; i < words.size(); ++i)
+        {
+            cout << "    WordView(" << literal(words[i]) << "),\n";
+        }
+        if (words.empty())
+        {
+            cout << "    WordView(), // placeholder, a C++ array cannot be empty\n";
+        }
+        cout << "};\n";
+        cout << "static_assert(wordViewsSorted(" << table << ", 0, " << words.size() << "), \"" << table << " must be sorted\");\n\n";
+    }
+    cout << "static constexpr StaticCategory " << prefix << "[] = {\n";
+    for (size_t c = 0; c < categories.size(); ++c)
+    {
+        cout << "    {" << literal(categories[c].name) << ", " << prefix << "_words_" << c << ", " << categories[c].words.size() << "},\n";
+    }
+    if (categories.empty())
+    {
+        cout << "    {\"\", nullptr, 0},\n";
+    }
+    cout << "};\n";
+    cout << "static constexpr size_t " << prefix << "_count = " << categories.size() << ";\n\n";
+    cout << "#endif // " << guard << "_H\n";
+    return 0;
+}
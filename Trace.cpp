@@ -0,0 +1,153 @@
+#include "Trace.h"
+#include <chrono>
+#include <cstdio>
+#include <memory> // unique_ptr
+#include <mutex>
+#include <vector>
+using namespace std;
+
+atomic<bool> Trace::on(false);
+
+namespace
+{
+    struct Span
+    {
+        const char *name;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    // Written by its thread only; written is stored after the span so a reader that loads it sees whole spans
+    struct Ring
+    {
+        Span spans[Trace::RING_CAPACITY];
+        atomic<uint64_t> written; // spans ever recorded, the next one goes to spans[written % RING_CAPACITY]
+        unsigned thread;          // 1, 2, ... in the order the rings were made
+        bool in_use;              // a live thread records into it, guarded by rings_mutex
+        Ring() : written(0), thread(0), in_use(true) {}
+    };
+
+    // Rings are owned here, not by their thread, so the spans of a thread that has ended are still exported.
+    // A ring whose thread has ended goes to the next thread that records, after the spans already in it, so every load
+    // (two new threads) does not leave two more rings behind : there are only as many rings as threads alive at once.
+    // The mutex guards the list and in_use only : it is taken once per thread, never per span.
+    mutex rings_mutex;
+    vector<unique_ptr<Ring>> rings;
+
+    // The ring of this thread, handed back when the thread ends
+    struct ThreadRing
+    {
+        Ring *ring;
+        ThreadRing() : ring(nullptr) {}
+        ~ThreadRing()
+        {
+            if (ring != nullptr)
+            {
+                lock_guard<mutex> lock(rings_mutex);
+                ring->in_use = false;
+            }
+        }
+    };
+    thread_local ThreadRing thread_ring;
+
+    Ring *threadRing()
+    {
+        if (thread_ring.ring == nullptr)
+        {
+            lock_guard<mutex> lock(rings_mutex);
+            for (size_t r = 0; r < rings.size() && thread_ring.ring == nullptr; ++r)
+            {
+                if (!rings[r]->in_use)
+                {
+                    rings[r]->in_use = true;
+                    thread_ring.ring = rings[r].get();
+                }
+            }
+            if (thread_ring.ring == nullptr)
+            {
+                unique_ptr<Ring> ring(new Ring());
+                ring->thread = static_cast<unsigned>(rings.size() + 1);
+                thread_ring.ring = ring.get();
+                rings.push_back(move(ring));
+            }
+        }
+        return thread_ring.ring;
+    }
+
+    void writeName(FILE *file, const char *name) // JSON string body
+    {
+        for (const char *p = name; *p != '\0'; ++p)
+        {
+            if (*p == '"' || *p == '\\')
+            {
+                fputc('\\', file);
+            }
+            fputc(*p, file);
+        }
+    }
+}
+
+void Trace::enable(bool enable)
+{
+    on.store(enable, memory_order_relaxed);
+}
+
+uint64_t Trace::now()
+{
+    uint64_t ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+    return ns != 0 ? ns : 1; // 0 means "not started" in TraceScope
+}
+
+void Trace::record(const char *name, uint64_t start, uint64_t end)
+{
+    Ring *ring = threadRing();
+    uint64_t n = ring->written.load(memory_order_relaxed);
+    Span &span = ring->spans[n & (RING_CAPACITY - 1)];
+    span.name = name;
+    span.start = start;
+    span.end = end;
+    ring->written.store(n + 1, memory_order_release);
+}
+
+// {"traceEvents":[{"name":"WordCat::insertWord","ph":"X","pid":1,"tid":1,"ts":12.345,"dur":0.250}, ...]}
+// ts and dur are in microseconds, ts counted from the earliest span kept
+bool Trace::exportJson(const char *filename)
+{
+    FILE *file = fopen(filename, "w");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    lock_guard<mutex> lock(rings_mutex);
+    uint64_t base = UINT64_MAX;
+    for (size_t r = 0; r < rings.size(); ++r)
+    {
+        uint64_t n = rings[r]->written.load(memory_order_acquire);
+        for (uint64_t i = n > RING_CAPACITY ? n - RING_CAPACITY : 0; i < n; ++i)
+        {
+            uint64_t start = rings[r]->spans[i & (RING_CAPACITY - 1)].start;
+            base = start < base ? start : base;
+        }
+    }
+    fputs("{\"traceEvents\":[", file);
+    bool first = true;
+    for (size_t r = 0; r < rings.size(); ++r)
+    {
+        const Ring &ring = *rings[r];
+        fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+                first ? "" : ",", ring.thread, ring.thread);
+        first = false;
+        uint64_t n = ring.written.load(memory_order_acquire);
+        for (uint64_t i = n > RING_CAPACITY ? n - RING_CAPACITY : 0; i < n; ++i)
+        {
+            const Span &span = ring.spans[i & (RING_CAPACITY - 1)];
+            fputs(",\n{\"name\":\"", file);
+            writeName(file, span.name);
+            fprintf(file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", ring.thread,
+                    (span.start - base) / 1000.0, (span.end - span.start) / 1000.0);
+        }
+    }
+    fputs("\n]}\n", file);
+    bool ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
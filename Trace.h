@@ -0,0 +1,57 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+
+// Timeline of what the program spent its time on, written out as a Chrome / Perfetto trace-event JSON file
+// (open it in chrome://tracing or ui.perfetto.dev).
+// TRACE_SCOPE("WordCat::insertWord"); at the top of a block records one span from there to the end of the block.
+// Each thread writes its spans into its own ring buffer with no lock; once a ring is full the oldest spans are overwritten.
+// When a thread ends its ring is reused by the next new thread, so short-lived threads do not add a ring each.
+// Tracing is off until Trace::enable() : a disabled scope is one relaxed load and a branch.
+// Build with -DNO_TRACE to compile every TRACE_SCOPE out.
+class Trace
+{
+public:
+    static const size_t RING_CAPACITY = 1 << 16; // spans kept per thread, a power of two
+
+    static void enable(bool enable = true);
+    static bool enabled() { return on.load(std::memory_order_relaxed); }
+    static uint64_t now(); // nanoseconds on the steady clock, never 0
+    static void record(const char *name, uint64_t start, uint64_t end); // name must outlive the trace (a string literal)
+    static bool exportJson(const char *filename); // false if the file cannot be written; call it while the traced threads are idle
+
+private:
+    static std::atomic<bool> on;
+};
+
+class TraceScope
+{
+private:
+    const char *name;
+    uint64_t start; // 0 when tracing was off as the scope began
+
+public:
+    explicit TraceScope(const char *name) : name(name), start(Trace::enabled() ? Trace::now() : 0) {}
+    ~TraceScope()
+    {
+        if (start != 0)
+        {
+            Trace::record(name, start, Trace::now());
+        }
+    }
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+};
+
+#ifdef NO_TRACE
+#define TRACE_SCOPE(name)
+#else
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#endif
+
+#endif // TRACE_H
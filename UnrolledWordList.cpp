@@ -0,0 +1,588 @@
+#include "UnrolledWordList.h"
+#include "Trace.h"
+#include <new> // placement new
+
+// The words of a block are constructed in place, so they are destroyed by hand
+UnrolledWordList::Block::~Block()
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        at(i).~Word();
+    }
+}
+
+// Default constructor : UnrolledWordList list; no block until the first word
+UnrolledWordList::UnrolledWordList() : head(nullptr), tail(nullptr), size(0), sorted(true) {}
+
+// Copy constructor : UnrolledWordList list1(list2); the copy is packed, every block but the last one is full
+UnrolledWordList::UnrolledWordList(const UnrolledWordList &other) : UnrolledWordList()
+{
+    for (const_iterator it = other.begin(); it != other.end(); ++it)
+    {
+        push_back(*it);
+    }
+}
+
+// Move constructor : UnrolledWordList list1(move(list2)); takes the blocks of list2
+UnrolledWordList::UnrolledWordList(UnrolledWordList &&other) noexcept
+    : head(other.head), tail(other.tail), size(other.size), sorted(other.sorted)
+{
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+    other.sorted = true;
+}
+
+// Copy assignment operator : UnrolledWordList list1 = list2;
+UnrolledWordList &UnrolledWordList::operator=(const UnrolledWordList &other)
+{
+    if (this != &other)
+    {
+        UnrolledWordList copy = other;
+        swap(*this, copy);
+    }
+    return *this;
+}
+
+// Move assignment operator : UnrolledWordList list1 = move(list2);
+UnrolledWordList &UnrolledWordList::operator=(UnrolledWordList &&other) noexcept
+{
+    if (this != &other)
+    {
+        swap(head, other.head);
+        swap(tail, other.tail);
+        swap(size, other.size);
+        swap(sorted, other.sorted);
+    }
+    return *this;
+}
+
+UnrolledWordList::~UnrolledWordList()
+{
+    clear();
+}
+
+// Remove every word, keeps the index setting
+void UnrolledWordList::clear()
+{
+    TRACE_SCOPE("UnrolledWordList::clear");
+    Block *block = head;
+    while (block != nullptr)
+    {
+        Block *next = block->next;
+        delete block;
+        block = next;
+    }
+    head = nullptr;
+    tail = nullptr;
+    size = 0;
+    sorted = true;
+}
+
+size_t UnrolledWordList::length() const
+{
+    return size;
+}
+
+size_t UnrolledWordList::occurrences() const
+{
+    return size;
+}
+
+bool UnrolledWordList::isEmpty() const
+{
+    return size == 0;
+}
+
+Word &UnrolledWordList::front()
+{
+    if (isEmpty())
+    {
+        throw std::runtime_error("List is empty");
+    }
+    return head->at(0);
+}
+
+Word &UnrolledWordList::back()
+{
+    if (isEmpty())
+    {
+        throw std::runtime_error("List is empty");
+    }
+    return tail->at(tail->count - 1);
+}
+
+// Link a new empty block after block, or in front of the list when block is nullptr
+UnrolledWordList::Block *UnrolledWordList::insertBlockAfter(Block *block)
+{
+    Block *fresh = new Block();
+    fresh->prev = block;
+    fresh->next = block != nullptr ? block->next : head;
+    if (fresh->next != nullptr)
+    {
+        fresh->next->prev = fresh;
+    }
+    else
+    {
+        tail = fresh;
+    }
+    if (block != nullptr)
+    {
+        block->next = fresh;
+    }
+    else
+    {
+        head = fresh;
+    }
+    return fresh;
+}
+
+// Unlink block and free it with whatever words are left in it
+void UnrolledWordList::eraseBlock(Block *block)
+{
+    if (block->prev != nullptr)
+    {
+        block->prev->next = block->next;
+    }
+    else
+    {
+        head = block->next;
+    }
+    if (block->next != nullptr)
+    {
+        block->next->prev = block->prev;
+    }
+    else
+    {
+        tail = block->prev;
+    }
+    delete block;
+}
+
+// Move the upper half of block into a new block right after it (the words are moved, not copied)
+void UnrolledWordList::split(Block *block)
+{
+    TRACE_SCOPE("UnrolledWordList::split");
+    Block *fresh = insertBlockAfter(block);
+    size_t half = block->count / 2;
+    for (size_t i = half; i < block->count; ++i)
+    {
+        new (&fresh->at(i - half)) Word(move(block->at(i)));
+        block->at(i).~Word();
+    }
+    fresh->count = block->count - half;
+    block->count = half;
+}
+
+// Shift the words from index one slot to the right and put word in the gap
+void UnrolledWordList::insertAt(Block *block, size_t index, const Word &word)
+{
+    if (index == block->count)
+    {
+        new (&block->at(index)) Word(word);
+    }
+    else
+    {
+        new (&block->at(block->count)) Word(move(block->at(block->count - 1)));
+        for (size_t i = block->count - 1; i > index; --i)
+        {
+            block->at(i) = move(block->at(i - 1));
+        }
+        block->at(index) = word;
+    }
+    block->count++;
+    size++;
+}
+
+// Close the gap left by the word at index; an empty block is freed and a block under a quarter full
+// is merged with a neighbour when both fit in one block
+void UnrolledWordList::eraseAt(Block *block, size_t index)
+{
+    for (size_t i = index; i + 1 < block->count; ++i)
+    {
+        block->at(i) = move(block->at(i + 1));
+    }
+    block->at(--block->count).~Word();
+    size--;
+    if (block->count == 0)
+    {
+        eraseBlock(block);
+        return;
+    }
+    if (block->count >= BLOCK_CAPACITY / 4)
+    {
+        return;
+    }
+    Block *into = block;
+    Block *from = block->next;
+    if (from == nullptr || block->count + from->count > BLOCK_CAPACITY)
+    {
+        into = block->prev;
+        from = block;
+        if (into == nullptr || into->count + from->count > BLOCK_CAPACITY)
+        {
+            return;
+        }
+    }
+    for (size_t i = 0; i < from->count; ++i)
+    {
+        new (&into->at(into->count + i)) Word(move(from->at(i)));
+    }
+    into->count += from->count;
+    eraseBlock(from); // destroys the moved-from words
+}
+
+void UnrolledWordList::push_front(const Word &word)
+{
+    sorted = sorted && (size == 0 || word <= head->at(0));
+    if (head == nullptr || head->count == BLOCK_CAPACITY)
+    {
+        insertBlockAfter(nullptr);
+    }
+    insertAt(head, 0, word);
+}
+
+void UnrolledWordList::push_back(const Word &word)
+{
+    sorted = sorted && (size == 0 || word >= tail->at(tail->count - 1));
+    if (tail == nullptr || tail->count == BLOCK_CAPACITY)
+    {
+        insertBlockAfter(tail);
+    }
+    insertAt(tail, tail->count, word);
+}
+
+Word UnrolledWordList::pop_front()
+{
+    if (isEmpty())
+    {
+        throw std::runtime_error("List is empty");
+    }
+    Word word(move(head->at(0)));
+    eraseAt(head, 0);
+    return word;
+}
+
+Word UnrolledWordList::pop_back()
+{
+    if (isEmpty())
+    {
+        throw std::runtime_error("List is empty");
+    }
+    Word word(move(tail->at(tail->count - 1)));
+    eraseAt(tail, tail->count - 1);
+    return word;
+}
+
+// Insert before the first word that is not smaller, like WordList::insertSorted
+// The block is found by comparing last words only, then the slot by binary search inside the block
+void UnrolledWordList::insertSorted(const Word &word)
+{
+    Block *block = head;
+    while (block != nullptr && block->at(block->count - 1) < word)
+    {
+        block = block->next;
+    }
+    if (block == nullptr) // greater than every word
+    {
+        push_back(word);
+        return;
+    }
+    size_t low = 0;
+    size_t high = block->count - 1; // the last word is known to be >= word
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (block->at(middle) < word)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    if (block->count == BLOCK_CAPACITY)
+    {
+        split(block);
+        if (low > block->count)
+        {
+            low -= block->count;
+            block = block->next;
+        }
+    }
+    insertAt(block, low, word);
+}
+
+// Find a word : in a sorted list the first block whose last word is not smaller is the only one that can hold it
+bool UnrolledWordList::search(const Word &word, Block *&block, size_t &index) const
+{
+    for (block = head; block != nullptr; block = block->next)
+    {
+        if (sorted)
+        {
+            if (block->at(block->count - 1) < word)
+            {
+                continue;
+            }
+            size_t low = 0;
+            size_t high = block->count - 1;
+            while (low < high)
+            {
+                size_t middle = low + (high - low) / 2;
+                if (block->at(middle) < word)
+                {
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+            index = low;
+            return block->at(low) == word;
+        }
+        for (index = 0; index < block->count; ++index)
+        {
+            if (block->at(index) == word)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool UnrolledWordList::remove(const Word &word)
+{
+    Block *block;
+    size_t index;
+    if (!search(word, block, index))
+    {
+        return false;
+    }
+    eraseAt(block, index);
+    return true;
+}
+
+bool UnrolledWordList::lookup(const Word &word) const
+{
+    Block *block;
+    size_t index;
+    return search(word, block, index);
+}
+
+UnrolledWordList::const_iterator UnrolledWordList::find(const Word &word) const
+{
+    Block *block;
+    size_t index;
+    return search(word, block, index) ? const_iterator(block, index) : end();
+}
+
+// Fetch the word at the specified index, whole blocks are skipped using their counts
+Word UnrolledWordList::fetchWord(int index) const
+{
+    if (index < 0 || static_cast<size_t>(index) >= size)
+    {
+        throw std::runtime_error("Index out of range");
+    }
+    size_t n = index;
+    Block *block = head;
+    while (n >= block->count)
+    {
+        n -= block->count;
+        block = block->next;
+    }
+    return block->at(n);
+}
+
+// Print the list with n words per line
+void UnrolledWordList::print(ostream &os, int n) const
+{
+    TRACE_SCOPE("UnrolledWordList::print");
+    int count = 0;
+    for (const Block *block = head; block != nullptr; block = block->next)
+    {
+        for (size_t i = 0; i < block->count; ++i)
+        {
+            os << block->at(i) << ' ';
+            if (++count % n == 0)
+            {
+                os << '\n';
+            }
+        }
+    }
+    if (count % n != 0)
+    {
+        os << '\n';
+    }
+}
+
+ostream &operator<<(ostream &os, const UnrolledWordList &list)
+{
+    for (const UnrolledWordList::Block *block = list.head; block != nullptr; block = block->next)
+    {
+        for (size_t i = 0; i < block->count; ++i)
+        {
+            os << block->at(i) << ' ';
+        }
+    }
+    return os;
+}
+
+// Merge two sorted lists in one walk : the words are moved (no characters copied) into full blocks,
+// each source block is freed as soon as it is used up. Equal words from this list come first.
+void UnrolledWordList::merge(UnrolledWordList &other)
+{
+    TRACE_SCOPE("UnrolledWordList::merge");
+    if (this == &other || other.isEmpty())
+    {
+        return;
+    }
+    Block *mine = head;
+    Block *theirs = other.head;
+    size_t i = 0;
+    size_t j = 0;
+    size_t total = size + other.size;
+    bool both_sorted = sorted && other.sorted;
+    head = nullptr;
+    tail = nullptr;
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+    other.sorted = true;
+    while (mine != nullptr || theirs != nullptr)
+    {
+        Block *&from = (theirs == nullptr || (mine != nullptr && mine->at(i) <= theirs->at(j))) ? mine : theirs;
+        size_t &at = &from == &mine ? i : j;
+        if (tail == nullptr || tail->count == BLOCK_CAPACITY)
+        {
+            insertBlockAfter(tail);
+        }
+        new (&tail->at(tail->count++)) Word(move(from->at(at)));
+        if (++at == from->count)
+        {
+            Block *next = from->next;
+            delete from; // destroys the moved-from words
+            from = next;
+            at = 0;
+        }
+    }
+    size = total;
+    sorted = both_sorted;
+}
+
+// A hash index is only kept by the linked WordList : here lookup is a block walk plus a binary search
+void UnrolledWordList::enableIndex(bool enable)
+{
+    if (enable)
+    {
+        throw runtime_error("The hash index needs the linked WordList (build without -DUNROLLED_WORDLIST).");
+    }
+}
+
+// Duplicates always keep a slot each here, folding them into counts is only done by the linked WordList
+void UnrolledWordList::enableCounts(bool enable)
+{
+    if (enable)
+    {
+        throw runtime_error("Duplicate counting needs the linked WordList (build without -DUNROLLED_WORDLIST).");
+    }
+}
+
+bool UnrolledWordList::hasCounts() const
+{
+    return false;
+}
+
+size_t UnrolledWordList::count(const Word &word) const
+{
+    size_t found = 0;
+    for (const Block *block = head; block != nullptr; block = block->next)
+    {
+        if (sorted && block->at(block->count - 1) < word) // every word of the block comes before word
+        {
+            continue;
+        }
+        for (size_t i = 0; i < block->count; ++i)
+        {
+            if (block->at(i) == word)
+            {
+                ++found;
+            }
+            else if (sorted && word < block->at(i)) // past the run of word
+            {
+                return found;
+            }
+        }
+    }
+    return found;
+}
+
+bool UnrolledWordList::hasIndex() const
+{
+    return false;
+}
+
+size_t UnrolledWordList::bytes() const
+{
+    size_t total = 0;
+    for (const Block *block = head; block != nullptr; block = block->next)
+    {
+        total += sizeof(Block);
+        for (size_t i = 0; i < block->count; ++i)
+        {
+            total += block->at(i).length() + 1;
+        }
+    }
+    return total;
+}
+
+// Empty slots of the blocks are unused, the rest of a block (links, count, Word objects) is structure
+MemoryUsage UnrolledWordList::memoryUsage() const
+{
+    MemoryUsage usage;
+    for (const Block *block = head; block != nullptr; block = block->next)
+    {
+        usage.addAllocation(sizeof(Block), 0, sizeof(Block) - (BLOCK_CAPACITY - block->count) * sizeof(Word));
+        for (size_t i = 0; i < block->count; ++i)
+        {
+            usage += block->at(i).memoryUsage();
+        }
+    }
+    return usage;
+}
+
+// Like merge with nothing to merge : the words move into new full blocks, each old block is freed once emptied
+void UnrolledWordList::shrinkToFit()
+{
+    TRACE_SCOPE("UnrolledWordList::shrinkToFit");
+    Block *from = head;
+    head = nullptr;
+    tail = nullptr;
+    while (from != nullptr)
+    {
+        for (size_t i = 0; i < from->count; ++i)
+        {
+            if (tail == nullptr || tail->count == BLOCK_CAPACITY)
+            {
+                insertBlockAfter(tail);
+            }
+            new (&tail->at(tail->count++)) Word(move(from->at(i)));
+        }
+        Block *next = from->next;
+        delete from;
+        from = next;
+    }
+}
+
+// Iterators : begin() is the first word of the head block, end() is past the last block
+UnrolledWordList::const_iterator UnrolledWordList::begin() const
+{
+    return const_iterator(head, 0);
+}
+
+UnrolledWordList::const_iterator UnrolledWordList::end() const
+{
+    return const_iterator(nullptr, 0);
+}
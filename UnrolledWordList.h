@@ -0,0 +1,114 @@
+#ifndef UNROLLEDWORDLIST_H
+#define UNROLLEDWORDLIST_H
+
+#include "WordList.h"
+#include <stdexcept>
+#include <iostream>
+using namespace std;
+
+// Same API and iteration order as WordList, but the words are kept BLOCK_CAPACITY at a time in a linked list of blocks.
+// A walk touches one block per BLOCK_CAPACITY words instead of one node per word, and a full block is split in two
+// on insert, so an insert only shifts the words of one block. A block left less than a quarter full by a removal
+// is merged into its neighbour when they fit together.
+// While every word went in through insertSorted / merge (or push_back / push_front in order) the list knows it is sorted
+// and lookup only compares the last word of each block, then binary searches one block.
+class UnrolledWordList
+{
+public:
+    static const size_t BLOCK_CAPACITY = 32;
+
+private:
+    struct Block
+    {
+        Block *next;
+        Block *prev;
+        size_t count; // words[0, count) are constructed
+        alignas(Word) unsigned char storage[BLOCK_CAPACITY * sizeof(Word)]; // raw so an empty slot costs no allocation
+
+        Block() : next(nullptr), prev(nullptr), count(0) {}
+        ~Block();
+        Word &at(size_t i) { return reinterpret_cast<Word *>(storage)[i]; }
+        const Word &at(size_t i) const { return reinterpret_cast<const Word *>(storage)[i]; }
+
+        Block(const Block &) = delete;
+        Block &operator=(const Block &) = delete;
+    };
+
+    Block *head;
+    Block *tail;
+    size_t size;
+    bool sorted; // every word is <= the next one
+
+    Block *insertBlockAfter(Block *block); // new empty block after block (at the front if block is nullptr)
+    void eraseBlock(Block *block);
+    void split(Block *block);                                  // moves the upper half of a full block into a new one
+    void insertAt(Block *block, size_t index, const Word &word); // block must not be full
+    void eraseAt(Block *block, size_t index);
+    bool search(const Word &word, Block *&block, size_t &index) const;
+
+public:
+    // Read-only forward iterator : for (UnrolledWordList::const_iterator it = list.begin(); it != list.end(); ++it)
+    class const_iterator
+    {
+    private:
+        const Block *block;
+        size_t index;
+        const_iterator(const Block *block, size_t index) : block(block), index(index) {}
+        friend class UnrolledWordList;
+
+    public:
+        const_iterator() : block(nullptr), index(0) {}
+        const Word &operator*() const { return block->at(index); }
+        const Word *operator->() const { return &block->at(index); }
+        const_iterator &operator++()
+        {
+            if (++index == block->count)
+            {
+                block = block->next;
+                index = 0;
+            }
+            return *this;
+        }
+        bool operator==(const const_iterator &other) const { return block == other.block && index == other.index; }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+    };
+
+    UnrolledWordList();
+    UnrolledWordList(const UnrolledWordList &other);
+    UnrolledWordList(UnrolledWordList &&other) noexcept;
+    UnrolledWordList &operator=(const UnrolledWordList &other);
+    UnrolledWordList &operator=(UnrolledWordList &&other) noexcept;
+    ~UnrolledWordList();
+
+    size_t length() const;
+    size_t occurrences() const; // same as length(), duplicates always have their own slot
+    bool isEmpty() const;
+    Word &front();
+    Word &back();
+    void push_front(const Word &word);
+    void push_back(const Word &word);
+    Word pop_front();
+    Word pop_back();
+    void insertSorted(const Word &word);
+    bool remove(const Word &word);
+    size_t count(const Word &word) const; // in a sorted list only the blocks that can hold word are read
+    Word fetchWord(int index) const;
+    void print(ostream &os, int n = 5) const;
+    bool lookup(const Word &word) const;
+    const_iterator find(const Word &word) const; // first copy of word, end() if there is none : a block walk plus a binary search when sorted
+    void merge(UnrolledWordList &other); // moves every word of the sorted list other into this sorted list, other ends up empty
+    void clear();
+    void enableIndex(bool enable = true); // throws runtime_error when turned on : lookup in a sorted list is already a block walk plus a binary search
+    bool hasIndex() const;
+    void enableCounts(bool enable = true); // throws runtime_error when turned on : duplicates keep a slot each (packed 32 to a block already)
+    bool hasCounts() const;
+    size_t bytes() const; // heap bytes used by the blocks and the characters
+    MemoryUsage memoryUsage() const;
+    void shrinkToFit(); // moves the words into full blocks, frees the rest
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    friend ostream &operator<<(ostream &os, const UnrolledWordList &list);
+};
+
+#endif // UNROLLEDWORDLIST_H
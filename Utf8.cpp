@@ -0,0 +1,173 @@
+#include "Utf8.h"
+#ifdef __SSE2__
+#include <emmintrin.h> // _mm_loadu_si128, _mm_movemask_epi8
+#endif
+
+// Length of the sequence starting at p (1 to 4), 0 if it is not valid UTF-8
+static size_t sequenceLength(const unsigned char *p, size_t left)
+{
+    unsigned char c = p[0];
+    if (c < 0x80)
+    {
+        return 1;
+    }
+    size_t n;
+    unsigned char low = 0x80; // allowed range of the second byte
+    unsigned char high = 0xBF;
+    if (c >= 0xC2 && c <= 0xDF)
+    {
+        n = 2;
+    }
+    else if (c >= 0xE0 && c <= 0xEF)
+    {
+        n = 3;
+        if (c == 0xE0)
+        {
+            low = 0xA0; // overlong
+        }
+        else if (c == 0xED)
+        {
+            high = 0x9F; // surrogates
+        }
+    }
+    else if (c >= 0xF0 && c <= 0xF4)
+    {
+        n = 4;
+        if (c == 0xF0)
+        {
+            low = 0x90; // overlong
+        }
+        else if (c == 0xF4)
+        {
+            high = 0x8F; // above U+10FFFF
+        }
+    }
+    else
+    {
+        return 0; // continuation byte, 0xC0, 0xC1 or 0xF5 and above
+    }
+    if (left < n || p[1] < low || p[1] > high)
+    {
+        return 0;
+    }
+    for (size_t i = 2; i < n; ++i)
+    {
+        if ((p[i] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+    }
+    return n;
+}
+
+bool utf8Valid(const char *data, size_t length)
+{
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(data);
+    size_t i = 0;
+    while (i < length)
+    {
+#ifdef __SSE2__
+        // sixteen bytes without the high bit set are all ASCII
+        while (i + 16 <= length && _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i))) == 0)
+        {
+            i += 16;
+        }
+        if (i == length)
+        {
+            break;
+        }
+#endif
+        if (p[i] < 0x80)
+        {
+            ++i;
+            continue;
+        }
+        size_t n = sequenceLength(p + i, length - i);
+        if (n == 0)
+        {
+            return false;
+        }
+        i += n;
+    }
+    return true;
+}
+
+uint32_t utf8Decode(const char *data, size_t length, size_t &consumed)
+{
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(data);
+    if (length == 0)
+    {
+        consumed = 0;
+        return 0;
+    }
+    size_t n = sequenceLength(p, length);
+    switch (n)
+    {
+    case 1:
+        consumed = 1;
+        return p[0];
+    case 2:
+        consumed = 2;
+        return ((p[0] & 0x1Fu) << 6) | (p[1] & 0x3Fu);
+    case 3:
+        consumed = 3;
+        return ((p[0] & 0x0Fu) << 12) | ((p[1] & 0x3Fu) << 6) | (p[2] & 0x3Fu);
+    case 4:
+        consumed = 4;
+        return ((p[0] & 0x07u) << 18) | ((p[1] & 0x3Fu) << 12) | ((p[2] & 0x3Fu) << 6) | (p[3] & 0x3Fu);
+    default:
+        consumed = 1;
+        return 0xFFFD; // replacement character
+    }
+}
+
+uint32_t utf8FoldCase(uint32_t c)
+{
+    if (c < 0x80) // ASCII
+    {
+        return (c >= 'A' && c <= 'Z') ? c + 32 : c;
+    }
+    if (c >= 0xC0 && c <= 0xDE && c != 0xD7) // Latin-1 capitals, except the multiplication sign
+    {
+        return c + 0x20;
+    }
+    if (c >= 0x100 && c <= 0x17F) // Latin Extended-A : capital / small pairs
+    {
+        if (c == 0x130 || c == 0x131 || c == 0x138 || c == 0x149 || c == 0x17F) // dotted I, dotless i, kra, 'n, long s
+        {
+            return c == 0x17F ? 's' : c;
+        }
+        if ((c >= 0x139 && c <= 0x148) || (c >= 0x179 && c <= 0x17E)) // these pairs start on an odd code point
+        {
+            return (c & 1) ? c + 1 : c;
+        }
+        if (c == 0x178) // Ÿ
+        {
+            return 0xFF;
+        }
+        return (c & 1) ? c : c + 1;
+    }
+    if (c >= 0x391 && c <= 0x3AB && c != 0x3A2) // Greek capitals
+    {
+        return c + 0x20;
+    }
+    if (c == 0x3C2) // final sigma
+    {
+        return 0x3C3;
+    }
+    if (c >= 0x410 && c <= 0x42F) // Cyrillic capitals А-Я
+    {
+        return c + 0x20;
+    }
+    if (c >= 0x400 && c <= 0x40F) // Cyrillic capitals Ѐ-Џ
+    {
+        return c + 0x50;
+    }
+    return c;
+}
+
+uint32_t utf8FirstLetter(const char *data, size_t length)
+{
+    size_t consumed;
+    return utf8FoldCase(utf8Decode(data, length, consumed));
+}
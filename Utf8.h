@@ -0,0 +1,24 @@
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <stdint.h>
+#include <cstddef>
+
+// UTF-8 helpers for multilingual vocabularies.
+// Validation skips ASCII 16 bytes at a time with SSE2 when available and checks every multi-byte sequence
+// (no overlong forms, no surrogates, nothing above U+10FFFF).
+
+bool utf8Valid(const char *data, size_t length);
+
+// Code point at the start of data, consumed is set to the number of bytes it takes.
+// An invalid sequence gives U+FFFD and consumes one byte; an empty input gives 0.
+uint32_t utf8Decode(const char *data, size_t length, size_t &consumed);
+
+// Simple (one to one) case folding : ASCII, Latin-1, Latin Extended-A, Greek and Cyrillic.
+// Code points outside those blocks, and letters whose folding needs several characters ("ß"), are returned as is.
+uint32_t utf8FoldCase(uint32_t code_point);
+
+// Folded first code point of a word, 0 for an empty word
+uint32_t utf8FirstLetter(const char *data, size_t length);
+
+#endif // UTF8_H
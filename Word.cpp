@@ -1,30 +1,57 @@
 #include "Word.h"
+#include "Utf8.h"
+#include <string> // read buffer
 
-// Default constructor : (Word w;) initializing word to point to a new array of size 1 (containing only the null character '\0') and size to 0. This is an empty word.
-Word::Word() : word(new char[1]), size(0)
+// Every empty word points here instead of allocating its own 1-byte array; it is never written to and never deleted
+char Word::empty_word[1] = {'\0'};
+
+// New array holding length characters and the null character, or the shared empty array when length is 0
+char *Word::copyOf(const char *input, size_t length)
+{
+    if (length == 0)
+    {
+        return empty_word;
+    }
+    char *copy = new char[length + 1];
+    memcpy(copy, input, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+void Word::release(char *characters)
 {
-    strcpy(word, "\0");
+    if (characters != empty_word)
+    {
+        delete[] characters;
+    }
 }
 
+// Default constructor : (Word w;) initializing word to point to the shared empty array (containing only the null character '\0') and size to 0. This is an empty word.
+Word::Word() : word(empty_word), size(0), initial(0) {}
+
 // Conversion constructor : Word w("hello"); input is a pointer to the first character of the array of characters that is input.
-Word::Word(const char *input) : word(new char[strlen(input) + 1]), size(strlen(input))
+Word::Word(const char *input) : word(copyOf(input, strlen(input))), size(strlen(input))
 {
-    strcpy(word, input);
+    initial = utf8FirstLetter(word, size);
 }
 
-// Copy constructor : Word w1("hello"); Word w2(w1); &other here is a reference to w1, so we are copying the word and size of w1 into the NEW array of characters and size variables of w2
-Word::Word(const Word &other) : word(new char[other.size + 1]), size(other.size) // // The dot operator (.) is used to access the members (variables, methods) of an object (so can access the word and size variables of w1 in previous example)
+// Constructor from a buffer : Word w(buffer, 5); copies 5 characters and adds the null character
+Word::Word(const char *input, size_t length) : word(copyOf(input, length)), size(length)
 {
-    strcpy(word, other.word);
+    initial = utf8FirstLetter(word, size);
 }
 
+// Copy constructor : Word w1("hello"); Word w2(w1); &other here is a reference to w1, so we are copying the word and size of w1 into the NEW array of characters and size variables of w2
+Word::Word(const Word &other) : word(copyOf(other.word, other.size)), size(other.size), initial(other.initial) {} // // The dot operator (.) is used to access the members (variables, methods) of an object (so can access the word and size variables of w1 in previous example)
+
 // Move constructor : Word w1("hello"); Word w2(std::move(w1))
 // && is an rvalue reference == binds to a temporary value that will be destroyed after the move constructor is called
-// to make sure that it does not also destroy our new word (w2) we set w1.word to nullptr, so w1 no longer points to the array of characters that w2 copied
-Word::Word(Word &&other) noexcept : word(other.word), size(other.size)
+// to make sure that it does not also destroy our new word (w2) we point w1.word at the shared empty array, so w1 no longer points to the array of characters that w2 took (and is still a valid empty word)
+Word::Word(Word &&other) noexcept : word(other.word), size(other.size), initial(other.initial)
 {
-    other.word = nullptr;
+    other.word = empty_word;
     other.size = 0;
+    other.initial = 0;
 }
 
 // Copy assignment operator : Word w1("hello"); Word w2 = w1;
@@ -32,10 +59,10 @@ Word &Word::operator=(const Word &other)
 {
     if (this != &other) // this is a pointer to the object that is calling the function (w2) and &other is a pointer to the object that is being passed in (w1) == if w2 is not w1
     {
-        delete[] word;                   // to make sure that w2 does not have a word already, we delete
-        word = new char[other.size + 1]; // allocate memory for the new word
-        size = other.size;               // set the size of the new word
-        strcpy(word, other.word);        // copy the new word into the word variable
+        release(word);                         // to make sure that w2 does not have a word already, we delete
+        word = copyOf(other.word, other.size); // allocate memory for the new word and copy it
+        size = other.size;                     // set the size of the new word
+        initial = other.initial;
     }
     return *this;
 }
@@ -45,11 +72,13 @@ Word &Word::operator=(Word &&other) noexcept
 {
     if (this != &other)
     {
-        delete[] word;
+        release(word);
         word = other.word;
         size = other.size;
-        other.word = nullptr;
+        initial = other.initial;
+        other.word = empty_word;
         other.size = 0;
+        other.initial = 0;
     }
     return *this;
 }
@@ -57,7 +86,7 @@ Word &Word::operator=(Word &&other) noexcept
 // Destructor : ~Word w;
 Word::~Word()
 {
-    delete[] word;
+    release(word);
 }
 
 // Accessor for length
@@ -78,19 +107,22 @@ const char *Word::c_str() const
 // Word w("hello"); w.changeWord(w2);
 void Word::changeWord(const Word &newWord) // function does not return any value (void)
 {
-    delete[] word;                     // delete the word that is already there
-    word = new char[newWord.size + 1]; // allocate memory for the new word
-    size = newWord.size;               // set the size of the new word
-    strcpy(word, newWord.word);        // copy the new word into the word variable
+    char *copy = copyOf(newWord.word, newWord.size); // copy first : newWord may be this word
+    release(word);                                   // delete the word that is already there
+    word = copy;
+    size = newWord.size; // set the size of the new word
+    initial = newWord.initial;
 }
 
 // Word w("hello"); w.changeWord("world");
 void Word::changeWord(const char *newWord)
 {
-    delete[] word;
-    word = new char[strlen(newWord) + 1];
-    size = strlen(newWord);
-    strcpy(word, newWord);
+    size_t length = strlen(newWord);
+    char *copy = copyOf(newWord, length);
+    release(word);
+    word = copy;
+    size = length;
+    initial = utf8FirstLetter(word, size);
 }
 
 // Concatenation method : Word w1("hello"); Word w2("world"); Word w3 = w1.concat(w2); // w3 will be "helloworld"
@@ -101,7 +133,9 @@ Word Word::concat(const Word &other, const char *delimiter) const // delimiter i
     strcpy(newWord, word);                                  // copy the first word into the new word
     strcat(newWord, delimiter);                             // concatenate the delimiter
     strcat(newWord, other.word);                            // concatenate the second word
-    return Word(newWord);                                   // return the new word
+    Word result(newWord);                                   // the Word makes its own copy
+    delete[] newWord;                                       // so the temporary array can be freed
+    return result;                                          // return the new word
 }
 
 // Comparison method
@@ -110,6 +144,29 @@ bool Word::isLess(const Word &other) const
     return strcmp(c_str(), other.c_str()) < 0; // if word is lexicographically less than other.word, return a negative number and therefore, true
 }
 
+// Hash of the characters : FNV-1a over the bytes, then a final mix so every output bit depends on every input bit
+uint64_t Word::hash(const char *data, size_t length)
+{
+    uint64_t h = 14695981039346656037ULL; // FNV offset basis
+    for (size_t i = 0; i < length; ++i)
+    {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 1099511628211ULL; // FNV prime
+    }
+    h ^= h >> 33; // murmur3 finalizer
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Word w("hello"); uint64_t h = w.hash(); // equal words give equal hashes
+uint64_t Word::hash() const
+{
+    return hash(c_str(), length());
+}
+
 // Method to get the n'th character
 char Word::at(size_t n) const // which index to get the character from
 {
@@ -120,21 +177,43 @@ char Word::at(size_t n) const // which index to get the character from
     throw std::out_of_range("Index out of range");
 }
 
+// First letter for "starts with" queries : Word w("Éte"); w.firstLetter() == 0xE9 (é), already folded so no work per query
+uint32_t Word::firstLetter() const
+{
+    return initial;
+}
+
+// Heap bytes of the characters : the characters are payload, the null character is structure (an empty word allocates nothing)
+MemoryUsage Word::memoryUsage() const
+{
+    MemoryUsage usage;
+    if (word != empty_word)
+    {
+        usage.addAllocation(size + 1, size, 1);
+    }
+    return usage;
+}
+
+bool Word::isValidUtf8() const
+{
+    return utf8Valid(word, size);
+}
+
 // Print method : Word myWord("example"); //myWord.print(std::cout);  prints "example"
 void Word::print(ostream &os) const
 {
     os << word;
 }
 
-// Read method
+// Read method : reads one whitespace separated word of any length
 void Word::read(istream &is)
 {
-    char buffer[1000];         // temporary array of characters to store the input
+    string buffer;             // grows as needed, so long words are neither truncated nor overflow
     is >> buffer;              // get the input from the input stream
-    delete[] word;             // delete the word that is already there
-    size = strlen(buffer);     // set the size of the new word
-    word = new char[size + 1]; // allocate memory for the new word
-    strcpy(word, buffer);      // copy the new word into the word variable
+    release(word);                      // delete the word that is already there
+    size = buffer.size();               // set the size of the new word
+    word = copyOf(buffer.data(), size); // allocate memory for the new word and copy it (with its null character)
+    initial = utf8FirstLetter(word, size);
 }
 
 // Overloaded insertion operator<< : Word myWord("example"); std::cout << myWord; //prints "example"
@@ -147,10 +226,8 @@ ostream &operator<<(ostream &os, const Word &word)
 // Overloaded extraction operator : Word myWord; std::cin >> myWord; // reads a word from the keyboard
 istream &operator>>(istream &in, Word &word) // first paramter is where the word will be read from, second parameter is the word to be read
 {
-    char temp[100];        // temporary array of characters to store the input
-    in >> temp;            // get the input from the input stream
-    word.changeWord(temp); // change the word to the input
-    return in;             // return the input stream
+    word.read(in); // reads a word of any length
+    return in;     // return the input stream
 }
 
 // Overloaded comparison operators
@@ -3,6 +3,8 @@
 
 #include <cstring> // for strcpy, strlen, etc.
 #include <iostream>
+#include <stdint.h> // uint64_t
+#include "MemoryUsage.h"
 using namespace std;
 
 class Word
@@ -10,10 +12,16 @@ class Word
 private:
     char *word;
     size_t size;
+    uint32_t initial; // case-folded first code point, worked out whenever the characters change
+
+    static char empty_word[1];                             // shared by every empty word
+    static char *copyOf(const char *input, size_t length); // new array, or empty_word when length is 0
+    static void release(char *characters);                 // delete[] unless it is empty_word
 
 public:
     Word();
     Word(const char *input);
+    Word(const char *input, size_t length); // first length characters of input, need not be null terminated
     Word(const Word &other);
     Word(Word &&other) noexcept;
     Word &operator=(const Word &other);
@@ -25,7 +33,12 @@ public:
     void changeWord(const char *newWord);
     Word concat(const Word &other, const char *delimiter = " ") const;
     bool isLess(const Word &other) const;
+    uint64_t hash() const;
+    static uint64_t hash(const char *data, size_t length);
     char at(size_t n) const;
+    uint32_t firstLetter() const; // case-folded first code point (UTF-8), 0 for an empty word
+    bool isValidUtf8() const;
+    MemoryUsage memoryUsage() const; // heap used by the characters, nothing for an empty word
     void print(ostream &os) const;
     void read(istream &is);
     friend ostream &operator<<(std::ostream &os, const Word &word);
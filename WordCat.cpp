@@ -1,31 +1,81 @@
 #include "WordCat.h" //which includes WordList.h and Word.h
-#include <fstream>   // fstream for file I/O
+#include "WordLog.h"
+#include "Trace.h"
 #include <stdexcept> // runtime_error
+#include <algorithm> // sort, unique
+#include <iterator>  // make_move_iterator
 #include <cctype>    // tolower : converts a letter to lowercase
+#include <fcntl.h>   // open
+#include <unistd.h>  // close, STDIN_FILENO
+#include "WordReader.h"
+#include "Utf8.h"
 using namespace std;
 
+double WordCat::filter_rate = 0.01;
+unsigned long WordCat::last_revision = 0;
+
 // Default constructor : WordCat word_cat;
-WordCat::WordCat() : category(), words() {}
+WordCat::WordCat() : category(), storage(LIST), shared_words(make_shared<CategoryWordList>()), fixed(nullptr), fixed_count(0), source_offset(0), source_length(0), filter_stale(true), revision(++last_revision), log(nullptr) {}
 
 // Constructor : for eg. WordCat word_cat(Word("fruits"));
 // creating an instance of the class WordCat (called word_cat) with category name "fruits" by calling the conversion constructor of Word class
 // uses reference so instead of copying word object, it uses the same object / memory location
-WordCat::WordCat(const Word &categoryName) : category(categoryName), words() {}
+WordCat::WordCat(const Word &categoryName) : category(categoryName), storage(LIST), shared_words(make_shared<CategoryWordList>()), fixed(nullptr), fixed_count(0), source_offset(0), source_length(0), filter_stale(true), revision(++last_revision), log(nullptr) {}
+
+// Constructor : WordCat word_cat(A1_dictionary[0]); the words stay in the table (no parsing, no sorting, no heap)
+WordCat::WordCat(const StaticCategory &table)
+    : category(table.name), storage(STATIC_TABLE), shared_words(make_shared<CategoryWordList>()), fixed(table.words), fixed_count(table.count), source_offset(0), source_length(0), filter_stale(true), revision(++last_revision), log(nullptr)
+{
+    for (size_t i = 0; i < fixed_count; ++i) // once, when the category is made
+    {
+        statistics.add(fixed[i].c_str(), fixed[i].length());
+    }
+}
+
+// Constructor : WordCat word_cat(dictionary->name(n), dictionary->words(n), dictionary->stats(n));
+// the words stay where they are until an edit thaws them, and the stats come with them, so no word is read here
+WordCat::WordCat(const Word &categoryName, const FrozenWordList &frozenWords, const WordStats &stats)
+    : category(categoryName), storage(FROZEN), shared_words(make_shared<CategoryWordList>()), frozen(frozenWords), fixed(nullptr), fixed_count(0), source_offset(0), source_length(0), statistics(stats), filter_stale(true), revision(++last_revision), log(nullptr)
+{
+}
 
-// Copy constructor : WordCat word_cat1(word_cat2);
-WordCat::WordCat(const WordCat &other) : category(other.category), words(other.words) {}
+// Copy constructor : WordCat word_cat1(word_cat2); the word list is shared, not copied, until one of the two edits it
+// The copy is not logged : its edits would be replayed onto the category it was copied from (addCategory attaches the log)
+WordCat::WordCat(const WordCat &other) : category(other.category), storage(other.storage), shared_words(other.shared_words), packed(other.packed),
+                                           frozen(other.frozen), fixed(other.fixed), fixed_count(other.fixed_count), source(other.source),
+                                           source_offset(other.source_offset), source_length(other.source_length), statistics(other.statistics), filter(other.filter), filter_stale(other.filter_stale),
+                                           revision(++last_revision), log(nullptr) {}
 
 // Move constructor : WordCat word_cat1(move(word_cat2));
 // std::move is used to cast an lvalue to an rvalue reference (temporary object), which allows us to call the move constructor
-WordCat::WordCat(WordCat &&other) noexcept : category(move(other.category)), words(move(other.words)) {}
+WordCat::WordCat(WordCat &&other) noexcept : category(move(other.category)), storage(other.storage), shared_words(move(other.shared_words)), packed(move(other.packed)),
+                                             frozen(move(other.frozen)), fixed(other.fixed), fixed_count(other.fixed_count), source(move(other.source)),
+                                             source_offset(other.source_offset), source_length(other.source_length), statistics(other.statistics), filter(move(other.filter)), filter_stale(other.filter_stale),
+                                             revision(++last_revision), log(other.log)
+{
+    other.revision = ++last_revision; // its pages must not reuse cursors into words it no longer has
+}
 
-// Copy assignment operator : word_cat1 = word_cat2;
+// Copy assignment operator : word_cat1 = word_cat2; not logged either, like the copy constructor
 WordCat &WordCat::operator=(const WordCat &other)
 {
     if (this != &other)
     {
         category = other.category;
-        words = other.words;
+        storage = other.storage;
+        shared_words = other.shared_words; // shared, not copied
+        packed = other.packed;
+        frozen = other.frozen; // four array copies
+        fixed = other.fixed;
+        fixed_count = other.fixed_count;
+        source = other.source;
+        source_offset = other.source_offset;
+        source_length = other.source_length;
+        statistics = other.statistics;
+        filter = other.filter;
+        filter_stale = other.filter_stale;
+        revision = ++last_revision;
+        log = nullptr;
     }
     return *this;
 }
@@ -36,85 +86,1081 @@ WordCat &WordCat::operator=(WordCat &&other) noexcept
     if (this != &other)
     {
         category = move(other.category);
-        words = move(other.words);
+        storage = other.storage;
+        shared_words = move(other.shared_words); // this category's old list is released, other keeps none (like the move constructor)
+        packed = move(other.packed);
+        frozen = move(other.frozen);
+        fixed = other.fixed;
+        fixed_count = other.fixed_count;
+        source = move(other.source);
+        source_offset = other.source_offset;
+        source_length = other.source_length;
+        statistics = other.statistics;
+        filter = move(other.filter);
+        filter_stale = other.filter_stale;
+        revision = ++last_revision;
+        other.revision = ++last_revision;
+        log = other.log;
     }
     return *this;
 }
 
+namespace
+{
+    // strcmp order for words given as (data, length), the data need not be null terminated
+    int compareWords(const char *a, size_t a_length, const char *b, size_t b_length)
+    {
+        int cmp = memcmp(a, b, a_length < b_length ? a_length : b_length);
+        if (cmp != 0)
+        {
+            return cmp;
+        }
+        return a_length < b_length ? -1 : (a_length > b_length ? 1 : 0);
+    }
+}
+
+// Cursor : positioned on the first word of category
+WordCat::Cursor::Cursor(const WordCat &category)
+    : storage(category.readable().storage), list(&category.words()), it(category.words().begin()), end(category.words().end()), packed(category.packed),
+      fixed(category.fixed), frozen(&category.frozen), index(0),
+      count(category.storage == FROZEN ? category.frozen.length() : category.fixed_count) {}
+
+bool WordCat::Cursor::valid() const
+{
+    switch (storage)
+    {
+    case FRONT_CODED:
+        return packed.valid();
+    case STATIC_TABLE:
+    case FROZEN:
+        return index < count;
+    default:
+        return it != end;
+    }
+}
+
+const char *WordCat::Cursor::data() const
+{
+    switch (storage)
+    {
+    case FRONT_CODED:
+        return packed.data();
+    case STATIC_TABLE:
+        return fixed[index].c_str();
+    case FROZEN:
+        return frozen->data(index);
+    default:
+        return it->c_str();
+    }
+}
+
+size_t WordCat::Cursor::length() const
+{
+    switch (storage)
+    {
+    case FRONT_CODED:
+        return packed.length();
+    case STATIC_TABLE:
+        return fixed[index].length();
+    case FROZEN:
+        return frozen->length(index);
+    default:
+        return it->length();
+    }
+}
+
+void WordCat::Cursor::next()
+{
+    switch (storage)
+    {
+    case FRONT_CODED:
+        packed.next();
+        break;
+    case STATIC_TABLE:
+    case FROZEN:
+        ++index;
+        break;
+    default:
+        ++it;
+        break;
+    }
+}
+
+// Compressed : binary search over the block heads ; table or frozen : binary search
+// List : when key is one of its words, find() jumps to its first copy (one probe of the hash index when the category is
+// indexed, a block walk and a binary search for the unrolled list); otherwise, or without the index, a walk from the
+// current word, O(n)
+void WordCat::Cursor::seek(const char *key, size_t key_length)
+{
+    switch (storage)
+    {
+    case FRONT_CODED:
+        packed.seek(key, key_length);
+        break;
+    case FROZEN:
+        index = frozen->lowerBound(key, key_length, index);
+        break;
+    case STATIC_TABLE:
+    {
+        size_t high = count;
+        while (index < high) // lower bound in [index, high)
+        {
+            size_t middle = index + (high - index) / 2;
+            if (compareWords(fixed[middle].c_str(), fixed[middle].length(), key, key_length) < 0)
+            {
+                index = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        break;
+    }
+    default:
+        if (it != end && compareWords(it->c_str(), it->length(), key, key_length) < 0) // key is ahead of the cursor
+        {
+            CategoryWordList::const_iterator found = list->find(Word(key, key_length)); // a sorted list : the first copy is the lower bound
+            if (found != end)
+            {
+                it = found;
+                break;
+            }
+        }
+        while (it != end && compareWords(it->c_str(), it->length(), key, key_length) < 0)
+        {
+            ++it;
+        }
+        break;
+    }
+}
+
+// Visit the words in sorted order, starting at the first word >= from (pass "" to visit them all)
+// the visitor returns false to stop early
+template <class Visit>
+void WordCat::forEachWord(const char *from, size_t from_length, Visit visit) const
+{
+    Cursor cursor(*this);
+    if (from_length > 0)
+    {
+        cursor.seek(from, from_length);
+    }
+    for (; cursor.valid() && visit(cursor.data(), cursor.length()); cursor.next())
+    {
+    }
+}
+
 // Print all words in the category
 void WordCat::printWords() const
 {
-    cout << words;
+    TRACE_SCOPE("WordCat::printWords");
+    forEachWord("", 0, [](const char *word, size_t length)
+                {
+                    cout.write(word, length) << ' ';
+                    return true;
+                });
+}
+
+// Page : WordCat::Page page(cat); starts before the first word
+WordCat::Page::Page(const WordCat &category)
+    : cursor(category), revision(category.revision), repeats(0), started(false) {}
+
+// Page : WordCat::Page page(cat, "m", 1); starts after every copy of "m", or after the first seen copies of it
+WordCat::Page::Page(const WordCat &category, const char *after, size_t after_length, size_t seen)
+    : cursor(category), revision(0), last(after, after_length), repeats(seen), started(true) {} // revision 0 : seek on first use
+
+// Print the next count words of page, separated by separator
+size_t WordCat::printPage(Page &page, size_t count, ostream &os, char separator) const
+{
+    TRACE_SCOPE("WordCat::printPage");
+    if (page.revision != revision) // edited (or another category) since the page was saved : seek past what was shown
+    {
+        page.cursor = Cursor(*this);
+        if (page.started)
+        {
+            page.cursor.seek(page.last.data(), page.last.size());
+            for (size_t skipped = 0; skipped < page.repeats && page.cursor.valid() &&
+                                     compareWords(page.cursor.data(), page.cursor.length(), page.last.data(), page.last.size()) == 0;
+                 ++skipped)
+            {
+                page.cursor.next();
+            }
+        }
+        page.revision = revision;
+    }
+    size_t shown = 0;
+    for (; shown < count && page.cursor.valid(); page.cursor.next(), ++shown)
+    {
+        const char *word = page.cursor.data();
+        size_t length = page.cursor.length();
+        os.write(word, length) << separator;
+        if (page.started && compareWords(word, length, page.last.data(), page.last.size()) == 0)
+        {
+            ++page.repeats;
+        }
+        else
+        {
+            page.last.assign(word, length);
+            page.repeats = 1;
+            page.started = true;
+        }
+    }
+    return shown;
+}
+
+// Show page_size words at a time, the user presses Enter for the next page or q to stop
+void WordCat::printWordsByPage(size_t page_size) const
+{
+    Page page(*this);
+    string answer;
+    cin.ignore(); // the newline left after the menu choice
+    while (printPage(page, page_size, cout) == page_size && page.cursor.valid())
+    {
+        cout << "\n-- more (Enter, q to stop) -- " << flush;
+        if (!getline(cin, answer) || answer == "q")
+        {
+            return;
+        }
+    }
+    cout << '\n';
 }
 
 // Insert a new word into the category
 void WordCat::insertWord(const Word &word)
 {
-    words.insertSorted(word); // method found in WordList class
+    TRACE_SCOPE("WordCat::insertWord");
+    makeEditable();           // no-op unless read-only
+    ownWords().insertSorted(word); // method found in WordList class
+    statistics.add(word.c_str(), word.length());
+    revision = ++last_revision;
+    if (log != nullptr)
+    {
+        log->append(WordLog::INSERT_WORD, category, word);
+    }
+    if (!filter_stale)
+    {
+        if (words().length() > filter.capacity()) // full : more keys would push the false-positive rate up
+        {
+            filter_stale = true;
+        }
+        else
+        {
+            filter.add(word.hash());
+        }
+    }
 }
 
-// Remove a word from the category
-void WordCat::removeWord(const Word &word)
+// Insert many words at once : the batch is sorted and merged into the list in one walk, O(n + m log m) for m words
+// instead of one walk of the list per word. Each word that goes in is logged as its own insert.
+size_t WordCat::insertWords(vector<Word> batch, DuplicatePolicy policy)
 {
-    if (!words.remove(word)) // method found in WordList class
-                             // if false
+    TRACE_SCOPE("WordCat::insertWords");
+    size_t added = mergeBatch(batch, policy == SKIP_DUPLICATES);
+    if (log != nullptr)
     {
-        cout << "Word not found in the category.\n";
+        for (size_t i = 0; i < added; ++i)
+        {
+            log->append(WordLog::INSERT_WORD, category, batch[i]);
+        }
     }
+    return added;
+}
+
+size_t WordCat::mergeBatch(vector<Word> &batch, bool skip_duplicates)
+{
+    if (batch.empty())
+    {
+        return 0;
+    }
+    makeEditable();
+    {
+        TRACE_SCOPE("sort"); // load phase
+        sort(batch.begin(), batch.end());
+    }
+    if (skip_duplicates)
+    {
+        batch.erase(unique(batch.begin(), batch.end()), batch.end());
+        size_t kept = 0;
+        CategoryWordList::const_iterator it = words().begin(); // both sorted : one walk finds the words already here
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            while (it != words().end() && *it < batch[i])
+            {
+                ++it;
+            }
+            if (it == words().end() || !(*it == batch[i]))
+            {
+                if (kept != i)
+                {
+                    batch[kept] = move(batch[i]);
+                }
+                ++kept;
+            }
+        }
+        batch.resize(kept);
+    }
+    CategoryWordList incoming;
+    {
+        TRACE_SCOPE("link"); // load phase : nodes for the batch, then one merge walk
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            incoming.push_back(batch[i]); // in order, so the list stays sorted
+        }
+    }
+    mergeRun(incoming);
+    return batch.size();
+}
+
+void WordCat::mergeRun(CategoryWordList &run)
+{
+    if (run.isEmpty())
+    {
+        return;
+    }
+    makeEditable();
+    bool add_to_filter = !filter_stale && words().occurrences() + run.occurrences() <= filter.capacity();
+    for (CategoryWordList::const_iterator it = run.begin(); it != run.end(); ++it)
+    {
+        statistics.add(it->c_str(), it->length());
+        if (add_to_filter)
+        {
+            filter.add(it->hash());
+        }
+    }
+    if (!add_to_filter)
+    {
+        filter_stale = true; // full : more keys would push the false-positive rate up
+    }
+    {
+        TRACE_SCOPE("link"); // load phase
+        ownWords().merge(run);
+    }
+    revision = ++last_revision;
+}
+
+WordCat::Loader::Loader(WordCat &category, bool logged) : category(category), logged(logged) {}
+
+void WordCat::Loader::add(const char *word, size_t length)
+{
+    batch.push_back(Word(word, length));
+    if (batch.size() >= BATCH_WORDS)
+    {
+        flush();
+    }
+}
+
+void WordCat::Loader::add(vector<Word> words)
+{
+    if (batch.empty())
+    {
+        batch = move(words);
+    }
+    else
+    {
+        batch.insert(batch.end(), make_move_iterator(words.begin()), make_move_iterator(words.end()));
+    }
+    if (batch.size() >= BATCH_WORDS)
+    {
+        flush();
+    }
+}
+
+// The batch becomes a sorted run, then carries up : two runs of the same level are merged into one of the next
+void WordCat::Loader::flush()
+{
+    if (batch.empty())
+    {
+        return;
+    }
+    {
+        TRACE_SCOPE("sort"); // load phase
+        sort(batch.begin(), batch.end());
+    }
+    if (logged && category.log != nullptr)
+    {
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            category.log->append(WordLog::INSERT_WORD, category.category, batch[i]);
+        }
+    }
+    CategoryWordList run;
+    {
+        TRACE_SCOPE("link"); // load phase
+        if (category.hasCounts())
+        {
+            run.enableCounts(); // duplicates fold here already, a run holds what the category will
+        }
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            run.push_back(batch[i]);
+        }
+        batch.clear();
+        for (size_t k = 0;; ++k)
+        {
+            if (k == runs.size())
+            {
+                runs.push_back(move(run));
+                break;
+            }
+            if (runs[k].isEmpty())
+            {
+                runs[k] = move(run);
+                break;
+            }
+            run.merge(runs[k]); // runs[k] ends up empty
+        }
+    }
+}
+
+void WordCat::Loader::finish()
+{
+    flush();
+    CategoryWordList all;
+    if (category.hasCounts())
+    {
+        all.enableCounts();
+    }
+    for (size_t k = 0; k < runs.size(); ++k) // smallest first
+    {
+        all.merge(runs[k]);
+    }
+    runs.clear();
+    category.mergeRun(all);
+}
+
+// Remove a word from the category, returns false if the word was not in it
+bool WordCat::removeWord(const Word &word)
+{
+    TRACE_SCOPE("WordCat::removeWord");
+    makeEditable();
+    if (!ownWords().remove(word)) // method found in WordList class
+    {
+        return false;
+    }
+    filter_stale = true; // bits cannot be taken out of a Bloom filter, rebuild it on the next search
+    statistics.remove(word.c_str(), word.length());
+    revision = ++last_revision;
+    if (log != nullptr)
+    {
+        log->append(WordLog::REMOVE_WORD, category, word);
+    }
+    return true;
 }
 
 // Clear all words in the category
 void WordCat::clearWords()
 {
-    while (!words.isEmpty()) // while the list is not empty
+    TRACE_SCOPE("WordCat::clearWords");
+    resetWords();
+    if (log != nullptr)
+    {
+        log->append(WordLog::CLEAR_CATEGORY, category);
+    }
+}
+
+void WordCat::resetWords()
+{
+    packed = FrontCodedList(); // nothing to decompress
+    frozen = FrozenWordList();
+    fixed = nullptr;
+    fixed_count = 0;
+    source.reset(); // a deferred category is cleared without reading it
+    storage = LIST;
+    filter = BloomFilter();
+    filter_stale = true;
+    dropWords(); // remove every word at once, keeps the hash index setting
+    statistics.clear();
+    revision = ++last_revision;
+}
+
+const CategoryWordList &WordCat::words() const
+{
+    static const CategoryWordList empty;
+    return shared_words ? *shared_words : empty;
+}
+
+// Reading a deferred category loads it, as the first edit does : the words are the same, only where they are kept changes
+const WordCat &WordCat::readable() const
+{
+    if (storage == DEFERRED)
     {
-        words.pop_front(); // remove the first word
+        const_cast<WordCat *>(this)->materialize(); // categories are never const objects, only const views of them
     }
+    return *this;
+}
+
+// Copy-on-write : the first edit after a copy clones the list, later edits find it unshared
+CategoryWordList &WordCat::ownWords()
+{
+    if (!shared_words)
+    {
+        shared_words = make_shared<CategoryWordList>();
+    }
+    else if (shared_words.use_count() > 1)
+    {
+        TRACE_SCOPE("WordCat::cloneWords");
+        shared_words = make_shared<CategoryWordList>(*shared_words);
+    }
+    return *shared_words;
+}
+
+// Cloning a list only to clear it would be wasted : a shared list gets a fresh empty one with the same settings
+void WordCat::dropWords()
+{
+    if (shared_words && shared_words.use_count() == 1)
+    {
+        shared_words->clear();
+        return;
+    }
+    shared_ptr<CategoryWordList> fresh = make_shared<CategoryWordList>();
+    fresh->enableIndex(words().hasIndex());
+    fresh->enableCounts(words().hasCounts());
+    shared_words = fresh;
 }
 
 // Modify the category name
 void WordCat::modifyCategoryName(const Word &newCategoryName)
 {
+    TRACE_SCOPE("WordCat::modifyCategoryName");
+    if (log != nullptr)
+    {
+        log->append(WordLog::RENAME_CATEGORY, category, newCategoryName);
+    }
     category = newCategoryName;
+    revision = ++last_revision;
 }
 
 // Search for a word in the category
 bool WordCat::searchWord(const Word &word) const
 {
-    return words.lookup(word); // lookup method found in WordList class, uses search method to find the word
+    TRACE_SCOPE("WordCat::searchWord");
+    readable();
+    if (storage == STATIC_TABLE) // a binary search over the table, no filter so the category stays off the heap
+    {
+        Cursor cursor(*this);
+        cursor.seek(word.c_str(), word.length());
+        return cursor.valid() && compareWords(cursor.data(), cursor.length(), word.c_str(), word.length()) == 0;
+    }
+    if (storage == FROZEN)
+    {
+        return frozen.contains(word); // binary search, the first byte array settles most steps
+    }
+    if (filter_stale || filter.falsePositiveRate() != filter_rate)
+    {
+        rebuildFilter();
+    }
+    if (!filter.mightContain(word.hash())) // definitely not here, no need to walk the words
+    {
+        return false;
+    }
+    if (storage == FRONT_CODED)
+    {
+        return packed.contains(word); // binary search over the block heads, then one block
+    }
+    return words().lookup(word); // lookup method found in WordList class, uses search method to find the word
+}
+
+// Size a new filter for the current words with room to grow by half, and add every word to it
+void WordCat::rebuildFilter() const
+{
+    TRACE_SCOPE("WordCat::rebuildFilter");
+    size_t count = length();
+    filter = BloomFilter(count + count / 2 + 32, filter_rate);
+    forEachWord("", 0, [this](const char *word, size_t length)
+                {
+                    filter.add(Word::hash(word, length));
+                    return true;
+                });
+    filter_stale = false;
+}
+
+// The rate must be one BloomFilter accepts as it is (it replaces any other by 0.01), otherwise every filter would
+// look out of date and searchWord would rebuild it on each call
+void WordCat::setFilterFalsePositiveRate(double rate)
+{
+    if (!(rate > 0.0 && rate < 1.0)) // NaN fails both
+    {
+        throw runtime_error("The false-positive rate must be between 0 and 1.");
+    }
+    filter_rate = rate;
+}
+
+double WordCat::filterFalsePositiveRate()
+{
+    return filter_rate;
 }
 
 // Show all words starting with a specific letter
-void WordCat::showWordsStartingWith(char letter) const
+void WordCat::showWordsStartingWith(char letter, ostream &os) const
 {
-    for (int i = 0; i < words.length(); ++i)
+    TRACE_SCOPE("WordCat::showWordsStartingWith");
+    char text[2] = {letter, '\0'};
+    showWordsStartingWith(text, os);
+}
+
+// Show all words whose first character is the first character of letter (UTF-8), ignoring case : "é" finds "Été" and "école"
+void WordCat::showWordsStartingWith(const char *letter, ostream &os) const
+{
+    TRACE_SCOPE("WordCat::showWordsStartingWith");
+    readable();
+    uint32_t wanted = utf8FirstLetter(letter, strlen(letter));
+    if (storage == LIST)
     {
-        Word word = words.fetchWord(i);             // fetchWord method found in WordList class, goes through the list and returns the word at the index
-        if (tolower(word.at(0)) == tolower(letter)) // comparing the first character of the word with the given letter
-                                                    // word.at(0) vs word[0] ; .at() performs bounds checking, [] does not
+        for (CategoryWordList::const_iterator it = words().begin(); it != words().end(); ++it)
         {
-            cout << word << ' ';
+            if (it->firstLetter() == wanted) // folded when the word was created, nothing to decode here
+            {
+                os << *it << ' ';
+            }
         }
     }
-    cout << '\n'; // new line
+    else
+    {
+        forEachWord("", 0, [wanted, &os](const char *word, size_t length)
+                    {
+                        if (utf8FirstLetter(word, length) == wanted) // comparing the first character of the word with the given letter
+                        {
+                            os.write(word, length) << ' ';
+                        }
+                        return true; // upper and lower case words are not next to each other, keep going
+                    });
+    }
+    os << '\n'; // new line
+}
+
+// Print every word that begins with prefix, each followed by separator; returns how many were printed
+// the list is sorted, so the scan stops at the first word past the prefix range
+size_t WordCat::printWordsWithPrefix(const char *prefix, ostream &os, char separator) const
+{
+    TRACE_SCOPE("WordCat::printWordsWithPrefix");
+    size_t prefixLength = strlen(prefix);
+    size_t count = 0;
+    forEachWord(prefix, prefixLength, [&](const char *word, size_t length)
+                {
+                    if (length < prefixLength || memcmp(word, prefix, prefixLength) != 0) // already past every word that could match
+                    {
+                        return false;
+                    }
+                    os.write(word, length) << separator;
+                    ++count;
+                    return true;
+                });
+    return count;
 }
 
-// Load words from a file
+// Load words from a file ("-" reads standard input)
 void WordCat::loadFromFile(const char *filename)
 {
-    ifstream file(filename); // ifstream class is part of the c++ standard library and is used to read from files
-    if (!file.is_open())     // same with is_open() (member function prvided by ifstream class)
+    TRACE_SCOPE("WordCat::loadFromFile");
+    if (strcmp(filename, "-") == 0)
+    {
+        loadFromFd(STDIN_FILENO);
+        return;
+    }
+    int fd = open(filename, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
     {
         throw runtime_error("Failed to open file.");
     }
-    char word[100];      // temporary array to store the word read from the file
-    while (file >> word) // extraction operator reads a word from the file and stores it in the word array, deliniated by whitespace
+    try
+    {
+        loadFromFd(fd);
+    }
+    catch (...)
+    {
+        close(fd);
+        throw;
+    }
+    close(fd);
+}
+
+// Load whitespace separated words from a file descriptor, a pipe for instance
+// the input goes through the reader's fixed buffer, each word is only copied when it is inserted
+void WordCat::loadFromFd(int fd)
+{
+    TRACE_SCOPE("WordCat::loadFromFd");
+    WordReader reader(fd);
+    const char *word;
+    size_t length;
+    size_t skipped = 0;
+    Loader loader(*this); // memory does not grow with the file, only with the words kept
+    {
+        TRACE_SCOPE("parse"); // load phase
+        while (reader.nextToken(word, length))
+        {
+            if (!utf8Valid(word, length)) // mostly ASCII, checked sixteen bytes at a time
+            {
+                ++skipped;
+                continue;
+            }
+            loader.add(word, length);
+        }
+    }
+    loader.finish();
+    if (skipped > 0)
+    {
+        cout << "Skipped " << skipped << " words that are not valid UTF-8.\n";
+    }
+}
+
+// Stream the category name and its words to an exporter
+void WordCat::exportTo(WordExporter &out) const
+{
+    TRACE_SCOPE("WordCat::exportTo");
+    out.beginCategory(category.c_str());
+    forEachWord("", 0, [&out](const char *word, size_t length)
+                {
+                    out.word(word, length);
+                    return true;
+                });
+    out.endCategory();
+}
+
+// One merge walk over both sorted categories, O(n + m). Each word is compared once with the current word
+// of the other category and kept according to where it appears; repeated words count once.
+WordCat WordCat::combine(const WordCat &other, const char *delimiter, bool keep_only_this, bool keep_both, bool keep_only_other) const
+{
+    TRACE_SCOPE("WordCat::combine");
+    WordCat result(category.concat(other.category, delimiter));
+    Cursor mine(*this);
+    Cursor theirs(other);
+    string previous; // last word handled, reused as a buffer for the whole walk
+    bool started = false;
+    while (true)
+    {
+        while (started && mine.valid() && compareWords(mine.data(), mine.length(), previous.data(), previous.size()) == 0)
+        {
+            mine.next(); // skip repeats of the word just handled
+        }
+        while (started && theirs.valid() && compareWords(theirs.data(), theirs.length(), previous.data(), previous.size()) == 0)
+        {
+            theirs.next();
+        }
+        if (!mine.valid() && !theirs.valid())
+        {
+            break;
+        }
+        int cmp;
+        if (!theirs.valid())
+        {
+            cmp = -1;
+        }
+        else if (!mine.valid())
+        {
+            cmp = 1;
+        }
+        else
+        {
+            cmp = compareWords(mine.data(), mine.length(), theirs.data(), theirs.length());
+        }
+        const Cursor &current = cmp <= 0 ? mine : theirs;
+        if (cmp < 0 ? keep_only_this : (cmp > 0 ? keep_only_other : keep_both))
+        {
+            result.ownWords().push_back(Word(current.data(), current.length())); // comes out sorted, no need for insertSorted
+            result.statistics.add(current.data(), current.length());
+        }
+        previous.assign(current.data(), current.length());
+        started = true;
+    }
+    return result;
+}
+
+WordCat WordCat::unionWith(const WordCat &other) const
+{
+    return combine(other, " + ", true, true, true);
+}
+
+WordCat WordCat::intersect(const WordCat &other) const
+{
+    return combine(other, " & ", false, true, false);
+}
+
+WordCat WordCat::difference(const WordCat &other) const
+{
+    return combine(other, " - ", true, false, false);
+}
+
+// cat1.merge(cat2); relinks the nodes of cat2 into cat1 in one walk, cat2 ends up empty
+void WordCat::merge(WordCat &other)
+{
+    TRACE_SCOPE("WordCat::merge");
+    if (this == &other)
+    {
+        return;
+    }
+    makeEditable();
+    other.makeEditable();
+    ownWords().merge(other.ownWords());
+    statistics += other.statistics; // other is cleared just below
+    filter_stale = true;
+    revision = ++last_revision;
+    if (log != nullptr)
+    {
+        log->append(WordLog::MERGE_CATEGORIES, category, other.category);
+    }
+    other.resetWords(); // part of the merge record, not a clear of its own
+}
+
+// Replace the WordList by its front-coded copy : one byte array instead of a node and a buffer per word
+// (a frozen category is unpacked first, one still backed by its compile-time table is left alone, it uses no heap at all)
+void WordCat::compress()
+{
+    TRACE_SCOPE("WordCat::compress");
+    if (storage == FRONT_CODED || storage == STATIC_TABLE)
+    {
+        return;
+    }
+    makeEditable();
+    packed = FrontCodedList(words());
+    dropWords(); // frees every node (unless another copy still holds them), the hash index setting is kept for decompress()
+    storage = FRONT_CODED;
+    revision = ++last_revision;
+}
+
+void WordCat::decompress()
+{
+    if (storage == FRONT_CODED)
+    {
+        makeEditable();
+    }
+}
+
+// Rebuild the WordList from the read-only form, the words come out sorted so push_back keeps the order
+void WordCat::makeEditable()
+{
+    if (storage == DEFERRED)
+    {
+        materialize();
+    }
+    if (storage == LIST)
+    {
+        return;
+    }
+    TRACE_SCOPE("WordCat::makeEditable"); // only the conversions, not every edit
+    for (Cursor cursor(*this); cursor.valid(); cursor.next())
+    {
+        ownWords().push_back(Word(cursor.data(), cursor.length()));
+    }
+    packed = FrontCodedList();
+    frozen = FrozenWordList();
+    fixed = nullptr; // the table itself is never modified
+    fixed_count = 0;
+    storage = LIST;
+    revision = ++last_revision;
+}
+
+void WordCat::attachLog(WordLog *new_log)
+{
+    log = new_log;
+}
+
+// Keep a hash table from word to node in the WordList : searchWord and removeWord no longer walk the list
+void WordCat::enableIndex(bool enable)
+{
+    TRACE_SCOPE("WordCat::enableIndex");
+    ownWords().enableIndex(enable);
+}
+
+// The words stay the same, only their nodes change; a read-only form keeps the setting for when it is made editable
+void WordCat::enableCounts(bool enable)
+{
+    TRACE_SCOPE("WordCat::enableCounts");
+    ownWords().enableCounts(enable);
+    revision = ++last_revision; // saved cursors may point at nodes that were folded away
+}
+
+bool WordCat::hasCounts() const
+{
+    return words().hasCounts();
+}
+
+// Editable : the list counts (one hash probe when indexed and counting); read-only : seek to the word and count its run
+size_t WordCat::count(const Word &word) const
+{
+    TRACE_SCOPE("WordCat::count");
+    readable();
+    if (storage == LIST)
+    {
+        return words().count(word);
+    }
+    size_t found = 0;
+    Cursor cursor(*this);
+    for (cursor.seek(word.c_str(), word.length()); cursor.valid(); cursor.next())
+    {
+        if (compareWords(cursor.data(), cursor.length(), word.c_str(), word.length()) != 0)
+        {
+            break;
+        }
+        ++found;
+    }
+    return found;
+}
+
+bool WordCat::isCompressed() const
+{
+    return storage == FRONT_CODED;
+}
+
+// Replace the WordList by its columnar copy : one blob for the characters instead of a buffer per word
+// (a compressed category is unpacked first, a category backed by its compile-time table is left alone)
+void WordCat::freeze()
+{
+    TRACE_SCOPE("WordCat::freeze");
+    if (storage == FROZEN || storage == STATIC_TABLE)
+    {
+        return;
+    }
+    makeEditable();
+    frozen = FrozenWordList(words());
+    dropWords();
+    storage = FROZEN;
+    revision = ++last_revision;
+}
+
+void WordCat::thaw()
+{
+    if (storage == FROZEN)
+    {
+        makeEditable();
+    }
+}
+
+bool WordCat::isFrozen() const
+{
+    return storage == FROZEN;
+}
+
+// The category keeps only where its words are, and their stats : cat.defer(path, offset, length, stats); ... cat.materialize();
+void WordCat::defer(const shared_ptr<const string> &file, uint64_t offset, uint64_t length, const WordStats &stats)
+{
+    resetWords();
+    statistics = stats;
+    source = file;
+    source_offset = offset;
+    source_length = length;
+    storage = DEFERRED;
+}
+
+// Read the section of the file, one word per line, through the reader's fixed buffer
+// (not an edit : nothing is logged)
+void WordCat::materialize()
+{
+    if (storage != DEFERRED)
+    {
+        return;
+    }
+    TRACE_SCOPE("WordCat::materialize");
+    shared_ptr<const string> file = source;
+    uint64_t offset = source_offset;
+    uint64_t length = source_length;
+    WordStats counted = statistics;
+    int fd = open(file->c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) // still deferred : the next read tries again
+    {
+        throw runtime_error("Failed to open " + *file + ".");
+    }
+    size_t skipped = 0;
+    resetWords();
+    Loader loader(*this, false); // not an edit : nothing is logged
+    try
+    {
+        if (lseek(fd, static_cast<off_t>(offset), SEEK_SET) == -1)
+        {
+            throw runtime_error("Failed to read " + *file + ".");
+        }
+        WordReader reader(fd);
+        const char *line;
+        size_t line_length;
+        {
+            TRACE_SCOPE("parse"); // load phase
+            while (reader.offset() < length && reader.nextLine(line, line_length))
+            {
+                if (line_length == 0)
+                {
+                    continue;
+                }
+                if (!utf8Valid(line, line_length))
+                {
+                    ++skipped;
+                    continue;
+                }
+                loader.add(line, line_length);
+            }
+        }
+        loader.finish();
+    }
+    catch (...)
+    {
+        close(fd);
+        defer(file, offset, length, counted); // drops what was read so far, the next read starts the section again
+        throw;
+    }
+    close(fd);
+    revision = ++last_revision;
+    if (skipped > 0)
+    {
+        cout << "Skipped " << skipped << " lines that are not valid UTF-8.\n";
+    }
+}
+
+bool WordCat::isDeferred() const
+{
+    return storage == DEFERRED;
+}
+
+bool WordCat::isStatic() const
+{
+    return storage == STATIC_TABLE;
+}
+
+// Bytes on the heap : the encoded array when compressed, otherwise what the list reports
+size_t WordCat::storageBytes() const
+{
+    if (storage == FRONT_CODED)
+    {
+        return packed.bytes();
+    }
+    if (storage == FROZEN)
+    {
+        return frozen.bytes();
+    }
+    if (storage == STATIC_TABLE)
+    {
+        return 0; // the table is part of the program image
+    }
+    return words().bytes();
+}
+
+MemoryUsage WordCat::memoryUsage() const
+{
+    TRACE_SCOPE("WordCat::memoryUsage");
+    MemoryUsage usage = category.memoryUsage();
+    usage += words().memoryUsage(); // a list shared between copies is counted by each of them
+    usage += packed.memoryUsage();
+    usage += frozen.memoryUsage();
+    usage += filter.memoryUsage(); // a compile-time table is in the program image and counts for nothing
+    return usage;
+}
+
+// Give back what the words do not need; a filter that has to be rebuilt anyway is dropped now
+void WordCat::shrinkToFit()
+{
+    TRACE_SCOPE("WordCat::shrinkToFit");
+    if (shared_words.use_count() == 1) // a shared list is left alone, compacting it would mean cloning it
+    {
+        shared_words->shrinkToFit();
+    }
+    if (filter_stale)
     {
-        Word wordObj(word);  // creating a Word object with the word read from the file
-        insertWord(wordObj); // inserting the word into the category
+        filter = BloomFilter();
     }
 }
 
+const WordStats &WordCat::stats() const
+{
+    return statistics;
+}
+
 // Run the interactive menu
 void WordCat::run()
 {
@@ -122,6 +1168,10 @@ void WordCat::run()
     while (choice != 0)  // while the user does not choose to exit
     {
         perform(choice); // perform (method below) the action based on the user's choice
+        if (log != nullptr)
+        {
+            log->commit(); // the edits of one action reach the disk together
+        }
         choice = menu(); // display the menu again and get the user's choice
     }
     cout << "bye.\n";
@@ -134,13 +1184,24 @@ int WordCat::menu() const // will not change any member variables
     cout << "Word Category: " << category.c_str() << '\n';
     cout << "===========================\n";
     cout << "1. Print all the words in this category\n";
-    cout << "2. Insert a new word into this category\n";
+    cout << "2. Insert new words into this category\n";
     cout << "3. Remove a given word from this category\n";
     cout << "4. Empty this category\n";
     cout << "5. Modify the category name\n";
     cout << "6. Search for a specific word in this category\n";
     cout << "7. Show all the words starting with a given letter\n";
     cout << "8. Load from a text file\n";
+    cout << "9. " << (storage == FRONT_CODED ? "Decompress" : "Compress") << " this category (" << storageBytes() << " bytes)\n";
+#ifdef UNROLLED_WORDLIST
+    cout << "10. Hash index (not available : this build keeps words in the unrolled list)\n";
+#else
+    cout << "10. Turn the hash index " << (words().hasIndex() ? "off" : "on") << " (exact search and remove in one probe)\n";
+#endif
+    cout << "11. " << (storage == FROZEN ? "Thaw" : "Freeze") << " this category (columnar read-only form)\n";
+    cout << "12. Print the words page by page\n";
+    cout << "13. Show statistics\n";
+    cout << "14. Count the occurrences of a word\n";
+    cout << "15. Turn duplicate counting " << (words().hasCounts() ? "off" : "on") << " (one node per distinct word)\n";
     cout << "0. Exit\n";
     cout << "===========================\n";
     cout << "Enter Your Choice: ";
@@ -159,16 +1220,18 @@ void WordCat::perform(int choice)
         break;
     case 2:
     {
-        char input[100]; // creating a temporary array to store the word
-        do
+        Word input; // grows to fit the word typed
+        vector<Word> batch; // inserted together when the user is done
+        cout << "Enter words, then 'exit' when done: ";
+        while (cin >> input && strcmp(input.c_str(), "exit") != 0) // if the user enters 'exit', the loop will stop
         {
-            cout << "Enter a word: ";
-            // temporary array to store the word, max size of 100 characters
-            // cin.ignore();            // ignore any characters from previous inputs or whitespace in the input buffer (because cin leaves the newline character ('\n') in the input buffer. If you were to call cin.getline() immediately after reading input with cin, cin.getline() would read the newline character and immediately stop)
-            // cin.getline(input, 100); // cin.getline(char_array, size) where char array is the where the input will be stored (declared beforehand here) and size is the maximum number of characters to read
-            cin >> input; // reads up to 99 char. + null terminator
-            insertWord(Word(input));
-        } while (strcmp(input, "exit") != 0); // if the user enters 'exit', the loop will stop
+            batch.push_back(input);
+        }
+        char answer;
+        cout << "Skip words already in the category? (y/n): ";
+        cin >> answer;
+        size_t added = insertWords(move(batch), answer == 'y' || answer == 'Y' ? SKIP_DUPLICATES : KEEP_DUPLICATES);
+        cout << added << " words added.\n";
         break;
     }
     case 3:
@@ -177,7 +1240,10 @@ void WordCat::perform(int choice)
         char input[100];
         cin.ignore();
         cin.getline(input, 100);
-        removeWord(Word(input));
+        if (!removeWord(Word(input))) // if false
+        {
+            cout << "Word not found in the category.\n";
+        }
         break;
     }
     case 4:
@@ -211,19 +1277,88 @@ void WordCat::perform(int choice)
     case 7:
     {
         cout << "Enter the starting letter: ";
-        char letter;   // creating a variable to store the letter
+        Word letter;   // creating a variable to store the letter, which can take several bytes in UTF-8
         cin >> letter; // user input stored in the letter variable
-        showWordsStartingWith(letter);
+        showWordsStartingWith(letter.c_str());
         break;
     }
     case 8:
     {
         cout << "Enter the filename to load from: ";
-        char filename[100];
+        Word filename;
         cin >> filename;
-        loadFromFile(filename);
+        loadFromFile(filename.c_str());
         break;
     }
+    case 9:
+        if (storage == FRONT_CODED)
+        {
+            decompress();
+        }
+        else
+        {
+            compress();
+        }
+        cout << "Words now use " << storageBytes() << " bytes.\n";
+        break;
+    case 10:
+        try
+        {
+            enableIndex(!words().hasIndex());
+        }
+        catch (const runtime_error &e)
+        {
+            cout << e.what() << endl;
+        }
+        break;
+    case 11:
+        if (storage == FROZEN)
+        {
+            thaw();
+        }
+        else
+        {
+            freeze();
+        }
+        cout << "Words now use " << storageBytes() << " bytes.\n";
+        break;
+    case 12:
+    {
+        size_t page_size;
+        cout << "Enter the number of words per page: ";
+        if (cin >> page_size && page_size > 0)
+        {
+            printWordsByPage(page_size);
+        }
+        else
+        {
+            cout << "Invalid page size.\n";
+        }
+        break;
+    }
+    case 13:
+        statistics.print(cout);
+        cout << '\n';
+        break;
+    case 14:
+    {
+        Word word;
+        cout << "Enter the word to count: ";
+        cin >> word;
+        cout << word << " occurs " << count(word) << " times.\n";
+        break;
+    }
+    case 15:
+        try
+        {
+            enableCounts(!words().hasCounts());
+        }
+        catch (const runtime_error &e)
+        {
+            cout << e.what() << endl;
+        }
+        cout << "Duplicate counting is " << (words().hasCounts() ? "on" : "off") << ".\n";
+        break;
     case 0:
         break;
     default:
@@ -237,10 +1372,27 @@ ostream &operator<<(ostream &os, const WordCat &wordCat) //
 // cout << wordCat; // prints Category: fruits Words: 5
 {
     os << "Category: " << wordCat.category.c_str() << '\n';
-    os << "Words: " << wordCat.words << '\n';
+    os << "Words: ";
+    wordCat.forEachWord("", 0, [&os](const char *word, size_t length)
+                        {
+                            os.write(word, length) << ' ';
+                            return true;
+                        });
+    os << '\n';
     return os;
 }
 
+// version method : changes whenever the words do, so a cached result can tell it is stale
+unsigned long WordCat::version() const
+{
+    return revision;
+}
+
+unsigned long WordCat::lastRevision()
+{
+    return last_revision;
+}
+
 // getName method : returns the category name
 Word WordCat::getName() const
 {
@@ -255,5 +1407,16 @@ const char *WordCat::c_str() const
 
 size_t WordCat::length() const
 {
-    return words.length();
+    readable();
+    switch (storage)
+    {
+    case FRONT_CODED:
+        return packed.length();
+    case FROZEN:
+        return frozen.length();
+    case STATIC_TABLE:
+        return fixed_count;
+    default:
+        return words().occurrences(); // a counted word is one node but several words, as in every other form
+    }
 }
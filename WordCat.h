@@ -1,22 +1,152 @@
 #ifndef WORDCAT_H
 #define WORDCAT_H
 
-#include "WordList.h"
+#include "UnrolledWordList.h"
+#include "FrontCodedList.h"
+#include "FrozenWordList.h"
+#include "BloomFilter.h"
 #include "Word.h"
+#include "WordExporter.h"
+#include "WordView.h"
+#include "WordStats.h"
 #include <iostream>
+#include <memory> // shared_ptr
+#include <string>
+#include <vector>
+
+// The list WordCat keeps its words in : compile with -DUNROLLED_WORDLIST to use the unrolled one
+#ifdef UNROLLED_WORDLIST
+typedef UnrolledWordList CategoryWordList;
+#else
+typedef WordList CategoryWordList;
+#endif
+
+class WordLog;
 
 class WordCat
 {
 private:
+    enum Storage
+    {
+        LIST,        // editable CategoryWordList
+        FRONT_CODED, // compressed read-only copy in packed
+        FROZEN,      // columnar read-only copy in frozen
+        STATIC_TABLE, // sorted compile-time table, not owned
+        DEFERRED      // still in a section of a file, read by materialize()
+    };
+
     Word category;
-    WordList words;
+    Storage storage;        // which of the members below holds the words
+    std::shared_ptr<CategoryWordList> shared_words; // the words while storage is LIST, shared by copies until one of them edits
+    FrontCodedList packed;  // the words while storage is FRONT_CODED
+    FrozenWordList frozen;  // the words while storage is FROZEN
+    const WordView *fixed;  // the words while storage is STATIC_TABLE
+    size_t fixed_count;
+    std::shared_ptr<const std::string> source; // the file holding the words while storage is DEFERRED
+    uint64_t source_offset;                    // where the section starts in source
+    uint64_t source_length;
+    WordStats statistics;   // follows every insert, removal and clear
+    mutable BloomFilter filter; // rejects most searches for words that are not in the category
+    mutable bool filter_stale;  // set by removals and clears, the filter is rebuilt by the next search
+    unsigned long revision;     // changes with every edit or change of form, never shared by two categories
+    WordLog *log;               // not owned, every edit is appended to it when set
+
+    static double filter_rate; // false-positive rate used when a filter is (re)built
+    static unsigned long last_revision;
 
     void perform(int choice);
     int menu() const;
+    void rebuildFilter() const;
+    void makeEditable(); // converts any read-only form back to a WordList, called by every edit
+    void resetWords();   // clearWords without logging
+    const CategoryWordList &words() const; // the list to read, an empty one after a move
+    const WordCat &readable() const;       // *this, a deferred category is read from its file first (throws like materialize)
+    CategoryWordList &ownWords();          // the list to edit : cloned first if another copy still holds it
+    void dropWords();                      // empties the list, a shared one is let go rather than cloned
+    size_t mergeBatch(std::vector<Word> &batch, bool skip_duplicates); // sorts batch and merges it in, without logging; batch keeps the words added
+    void mergeRun(CategoryWordList &run); // moves the sorted list run into the words (statistics and filter too), run ends up empty
+    WordCat combine(const WordCat &other, const char *delimiter, bool keep_only_this, bool keep_both, bool keep_only_other) const;
+    template <class Visit>
+    void forEachWord(const char *from, size_t from_length, Visit visit) const; // visit(data, length) from the first word >= from until it returns false
 
 public:
+    enum DuplicatePolicy
+    {
+        KEEP_DUPLICATES, // every word of the batch goes in, like insertWord
+        SKIP_DUPLICATES  // a word already in the category, or earlier in the batch, is left out
+    };
+
+    // Streams words into a category without holding the whole input : every BATCH_WORDS words are sorted into a run,
+    // and the runs are merged pairwise like a binary counter (runs[k] holds about 2^k batches), so a word takes part in
+    // O(log(n / BATCH_WORDS)) merge walks instead of one walk of the whole list per batch.
+    // WordCat::Loader loader(cat); loader.add(word, length); ... loader.finish(); // the words are in cat after finish()
+    class Loader
+    {
+    private:
+        WordCat &category;
+        bool logged; // each batch is logged as it is sorted, like insertWords
+        std::vector<Word> batch;
+        std::vector<CategoryWordList> runs; // runs[k] is empty or about 2^k batches
+
+        void flush();
+
+    public:
+        static const size_t BATCH_WORDS = 4096; // words held before they are sorted into a run
+
+        explicit Loader(WordCat &category, bool logged = true);
+        void add(const char *word, size_t length);
+        void add(std::vector<Word> words); // e.g. a batch of the load pipeline
+        void finish(); // merges every run into the category, the loader can then be used again
+    };
+
+    // Walks the words in sorted order whichever form the category is in :
+    // for (WordCat::Cursor cursor(cat); cursor.valid(); cursor.next()) { cursor.data(), cursor.length() }
+    // the category must not be edited while a cursor is in use
+    class Cursor
+    {
+    private:
+        Storage storage;
+        const CategoryWordList *list; // seek() asks it to find a word
+        CategoryWordList::const_iterator it;
+        CategoryWordList::const_iterator end;
+        FrontCodedList::Cursor packed;
+        const WordView *fixed;
+        const FrozenWordList *frozen;
+        size_t index; // position in fixed or frozen
+        size_t count;
+
+    public:
+        explicit Cursor(const WordCat &category);
+        bool valid() const;
+        const char *data() const; // not null terminated when the category is compressed
+        size_t length() const;
+        void next();
+        void seek(const char *key, size_t key_length); // forward to the first word >= key
+    };
+
+    // Where the next page of printPage starts. While the category is not edited the saved cursor simply carries on (O(1)),
+    // after an edit the page finds its place again by seeking past the last word it showed : O(log n) for the read-only
+    // forms, one hash probe for an indexed list (menu 10) still holding that word, otherwise a walk of the list, O(n).
+    // WordCat::Page page(cat); while (cat.printPage(page, 20, cout) > 0) { ... }
+    class Page
+    {
+    private:
+        Cursor cursor;
+        unsigned long revision; // of the category when cursor was saved
+        std::string last;       // last word shown
+        size_t repeats;         // how many copies of last were shown
+        bool started;
+        friend class WordCat;
+
+    public:
+        explicit Page(const WordCat &category); // from the first word
+        Page(const WordCat &category, const char *after, size_t after_length, size_t seen = SIZE_MAX); // after seen copies of after (all of them by default)
+    };
+
     WordCat();
     WordCat(const Word &categoryName);
+    explicit WordCat(const StaticCategory &table); // read-only view of a compile-time table, no copy is made
+    WordCat(const Word &categoryName, const FrozenWordList &frozenWords, const WordStats &stats); // frozen from the start, e.g. a view of a SharedDictionary, with the stats of its words
 
     WordCat(const WordCat &other);
     WordCat(WordCat &&other) noexcept;
@@ -26,16 +156,51 @@ public:
 
     void run();
     void printWords() const;
+    size_t printPage(Page &page, size_t count, std::ostream &os, char separator = ' ') const; // next count words at most, returns how many
+    void printWordsByPage(size_t page_size) const; // interactive : Enter shows the next page, q stops
     void insertWord(const Word &word);
-    void removeWord(const Word &word);
+    size_t insertWords(std::vector<Word> batch, DuplicatePolicy policy = KEEP_DUPLICATES); // one sort and one merge walk, returns how many went in
+    bool removeWord(const Word &word);
     void clearWords();
     void modifyCategoryName(const Word &newCategoryName);
     bool searchWord(const Word &word) const;
-    void showWordsStartingWith(char letter) const;
+    void showWordsStartingWith(char letter, std::ostream &os = std::cout) const;
+    void showWordsStartingWith(const char *letter, std::ostream &os = std::cout) const; // letter is UTF-8, the comparison ignores case
+    size_t printWordsWithPrefix(const char *prefix, std::ostream &os, char separator = ' ') const;
     void loadFromFile(const char *filename);
+    void loadFromFd(int fd);
+    void exportTo(WordExporter &out) const;
+    WordCat unionWith(const WordCat &other) const;  // words in either category, named "this + other"
+    WordCat intersect(const WordCat &other) const;  // words in both categories, named "this & other"
+    WordCat difference(const WordCat &other) const; // words in this category only, named "this - other"
+    void merge(WordCat &other);                     // moves every word of other into this category, duplicates kept
+    void compress();   // switch to the front-coded read-only form
+    void decompress(); // back to an editable WordList (done automatically by every edit)
+    bool isCompressed() const;
+    void freeze(); // switch to the columnar read-only form : one character blob plus offset and length arrays
+    void thaw();   // back to an editable WordList (done automatically by every edit)
+    bool isFrozen() const;
+    bool isStatic() const; // still backed by its compile-time table
+    void defer(const std::shared_ptr<const std::string> &file, uint64_t offset, uint64_t length, const WordStats &stats); // words are read on materialize(), stats counted by whoever scanned the file
+    void materialize(); // reads the words of a deferred category (one word per line); throws runtime_error and stays deferred if the file cannot be read
+    bool isDeferred() const; // the words are still in the file : every read materializes them first
+    void attachLog(WordLog *log); // nullptr stops logging
+    void enableIndex(bool enable = true); // O(1) expected searchWord / removeWord on the editable form; throws runtime_error with the unrolled list
+    void enableCounts(bool enable = true); // multiset mode : one node per distinct word with a count, walks still see every copy
+    bool hasCounts() const;
+    size_t count(const Word &word) const;  // occurrences of word, in any form
+    size_t storageBytes() const; // heap bytes used by the words
+    MemoryUsage memoryUsage() const; // name, words in whichever form, filter (a deferred category only counts what is loaded)
+    void shrinkToFit();
+    const WordStats &stats() const; // kept up to date by every edit, no walk; a deferred category is not read for them
+
+    static void setFilterFalsePositiveRate(double rate); // e.g. 0.01, applies as each filter is next rebuilt; throws runtime_error outside (0, 1)
+    static double filterFalsePositiveRate();
+    unsigned long version() const; // changes with every edit, rename or change of form, never shared by two categories
+    static unsigned long lastRevision(); // the newest version of any category : unchanged means no category changed
     Word getName() const; // takes no arguments and returns word, the category name
     const char *c_str() const;
-    size_t length() const;
+    size_t length() const; // every word, duplicates included, whichever form the category is in (what a Cursor walks)
 
     friend std::ostream &operator<<(std::ostream &os, const WordCat &wordCat);
 };
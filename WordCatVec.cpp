@@ -1,10 +1,20 @@
 #include "WordCatVec.h"
-#include <fstream>
+#include "WordReader.h"
+#include "Utf8.h"
+#include "A1_dictionary.h"
+#include "WordLog.h"
+#include "MergedWordCursor.h"
+#include "Trace.h"
+#include "LoadPipeline.h"
+#include "SharedDictionary.h"
 #include <iostream>
+#include <sstream> // ostringstream, istringstream : a category prints its matches, which are split into the cached result
 #include <cstring>
+#include <fcntl.h>  // open
+#include <unistd.h> // close
 using namespace std;
 
-WordCatVec::WordCatVec() : capacity(1), size(0) // default constructor : if write WordCatVec word_cat_vec; it will call this constructor
+WordCatVec::WordCatVec() : capacity(1), size(0), log(nullptr) // default constructor : if write WordCatVec word_cat_vec; it will call this constructor
 {
     word_category = new WordCat[capacity]; // dynamically allocate memory for the array of WordCat objects
 }
@@ -16,34 +26,119 @@ WordCatVec::~WordCatVec()
 
 void WordCatVec::resize(size_t new_capacity)
 {
+    TRACE_SCOPE("WordCatVec::resize");
     WordCat *new_array = new WordCat[new_capacity]; // dynamically allocate memory for the new array of WordCat objects
     for (size_t i = 0; i < size; ++i)
-    { // copy the old array into the new array
-        new_array[i] = word_category[i];
+    { // move the old array into the new array
+        new_array[i] = move(word_category[i]); // the words are handed over, not copied
     }
     delete[] word_category;    // deallocate memory for the old array
     word_category = new_array; // point the word_category pointer to the new array
     capacity = new_capacity;   // set the capacity to the new capacity
 }
 
+WordCat *WordCatVec::findCategory(const char *category_name) const // returns nullptr if there is no category with that name
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (strcmp(word_category[i].c_str(), category_name) == 0)
+        {
+            return &word_category[i];
+        }
+    }
+    return nullptr;
+}
+
+WordCat *WordCatVec::findLoaded(const char *category_name) const
+{
+    WordCat *category = findCategory(category_name);
+    if (category != nullptr)
+    {
+        category->materialize(); // no-op unless the category was loaded lazily; a file that went away throws, the category stays deferred
+    }
+    return category;
+}
+
+WordCat &WordCatVec::loaded(size_t n) const
+{
+    word_category[n].materialize();
+    return word_category[n];
+}
+
 void WordCatVec::addCategory(const WordCat &category)
 {
+    addCategory(WordCat(category));
+}
+
+void WordCatVec::addCategory(WordCat &&new_category) // the words are moved into the array, not copied
+{
+    TRACE_SCOPE("WordCatVec::addCategory");
     if (size == capacity)
     { // if the size is equal to the capacity, resize the array
         resize(capacity * 2);
     }
-    word_category[size++] = category; // add category to the end of the array
+    word_category[size++] = move(new_category); // add category to the end of the array
+    WordCat &category = word_category[size - 1];
+    category.attachLog(log);
+    if (log != nullptr) // the category and every word it came with
+    {
+        log->append(WordLog::ADD_CATEGORY, category.getName());
+        for (WordCat::Cursor cursor(category); cursor.valid(); cursor.next())
+        {
+            log->append(WordLog::INSERT_WORD, category.c_str(), strlen(category.c_str()), cursor.data(), cursor.length());
+        }
+    }
+}
+
+// The categories point into the tables, nothing is copied until a category is edited
+void WordCatVec::addStaticCategories(const StaticCategory *tables, size_t count)
+{
+    TRACE_SCOPE("WordCatVec::addStaticCategories");
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (findCategory(tables[i].name) == nullptr)
+        {
+            addCategory(WordCat(tables[i]));
+        }
+    }
+}
+
+// The copies share their word lists with other (copy-on-write), each one is logged like any new category
+size_t WordCatVec::addMissingCategories(const WordCatVec &other)
+{
+    TRACE_SCOPE("WordCatVec::addMissingCategories");
+    size_t added = 0;
+    for (size_t i = 0; i < other.length(); ++i)
+    {
+        const WordCat &category = other.at(i); // read in first if it was loaded lazily
+        if (findCategory(category.c_str()) == nullptr)
+        {
+            addCategory(category);
+            ++added;
+        }
+    }
+    return added;
+}
+
+void WordCatVec::loadBuiltinCategories()
+{
+    addStaticCategories(A1_dictionary, A1_dictionary_count);
 }
 
 void WordCatVec::removeCategory(const char *category_name)
 {
+    TRACE_SCOPE("WordCatVec::removeCategory");
     for (size_t i = 0; i < size; ++i) // loop through the array of WordCat objects
     {
         if (strcmp(word_category[i].getName().c_str(), category_name) == 0) // compares two character arrays so need to make a conversion to c-style string method on WordCat
         {                                                                   // if the category name is found
+            if (log != nullptr) // before the shift, category_name may be the name of the category itself
+            {
+                log->append(WordLog::REMOVE_CATEGORY, category_name, strlen(category_name));
+            }
             for (size_t j = i; j < size - 1; ++j)                           // loop through the array starting from the index of the category to remove, found in the previous loop
             {
-                word_category[j] = word_category[j + 1]; // move the next category to the current index for all categories after the one to remove
+                word_category[j] = move(word_category[j + 1]); // move the next category to the current index for all categories after the one to remove
                                                          // do size - 1 so that j + 1 does not go out of bounds
             }
             --size;                                  // decrement the size of the array
@@ -59,6 +154,7 @@ void WordCatVec::removeCategory(const char *category_name)
 
 void WordCatVec::clearCategory(const char *category_name)
 {
+    TRACE_SCOPE("WordCatVec::clearCategory");
     for (size_t i = 0; i < size; ++i)
     {
         if (strcmp(word_category[i].getName().c_str(), category_name) == 0)
@@ -72,102 +168,522 @@ void WordCatVec::clearCategory(const char *category_name)
 
 void WordCatVec::modifyCategory(const char *category)
 {
+    TRACE_SCOPE("WordCatVec::modifyCategory");
     for (size_t i = 0; i < size; ++i)
     {
         if (strcmp(word_category[i].getName().c_str(), category) == 0) // strcmp gives 0 if the two strings are equal
         {
-            word_category[i].run(); // runs the WordCat run method because object is of type WordCat (word_category = new WordCat[capacity];)
+            loaded(i).run(); // runs the WordCat run method because object is of type WordCat (word_category = new WordCat[capacity];)
             return;
         }
     }
     cout << "Category not found." << endl;
 }
 
+// One query over the categories, computed category by category so the cache only redoes the edited ones
+struct WordCatVec::QuerySource
+{
+    enum Kind
+    {
+        SEARCH, // names of the categories holding the word
+        PREFIX, // words beginning with the prefix
+        LINES   // what each category prints for showWordsStartingWith
+    };
+
+    const WordCatVec &vocabulary;
+    Kind kind;
+    const char *argument;
+
+    unsigned long stamp() const
+    {
+        return WordCat::lastRevision();
+    }
+
+    size_t count() const
+    {
+        return vocabulary.size;
+    }
+
+    unsigned long version(size_t i) const
+    {
+        return vocabulary.word_category[i].version();
+    }
+
+    void compute(size_t i, QueryCache::Result &part) const
+    {
+        const WordCat &category = vocabulary.loaded(i);
+        ostringstream out;
+        switch (kind)
+        {
+        case SEARCH:
+            if (category.searchWord(Word(argument)))
+            {
+                part.push_back(category.c_str());
+            }
+            break;
+        case PREFIX:
+        {
+            category.printWordsWithPrefix(argument, out, '\n');
+            istringstream in(out.str());
+            for (string word; getline(in, word);)
+            {
+                part.push_back(word);
+            }
+            break;
+        }
+        case LINES:
+            category.showWordsStartingWith(argument, out);
+            part.push_back(out.str());
+            break;
+        }
+    }
+};
+
+void WordCatVec::showWordsStartingWith(const char *letter) const
+{
+    TRACE_SCOPE("WordCatVec::showWordsStartingWith");
+    QuerySource source = {*this, QuerySource::LINES, letter};
+    const QueryCache::Result &lines = cache.get(string("L\t") + letter, source); // the line of each category
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        cout << lines[i];
+    }
+}
+
 void WordCatVec::showWordsStartingWith(char letter) const
 {
-    for (size_t i = 0; i < size; ++i) // goes through all the categories
+    char text[2] = {letter, '\0'};
+    showWordsStartingWith(text); // same cache entry as the string form
+}
+
+// One k-way merge over the categories : stops after limit words without looking at the rest, returns how many were printed
+size_t WordCatVec::printSortedWithPrefix(const char *prefix, size_t limit, ostream &os) const
+{
+    TRACE_SCOPE("WordCatVec::printSortedWithPrefix");
+    size_t count = 0;
+    for (MergedWordCursor cursor(*this, prefix); cursor.valid() && count < limit; cursor.next())
     {
-        word_category[i].showWordsStartingWith(letter); // calls the showWordsStartingWith method in WordCat class
+        os.write(cursor.data(), cursor.length()) << '\t' << cursor.category().c_str() << '\n';
+        ++count;
     }
+    return count;
 }
 
 void WordCatVec::loadFromFile(const char *filename)
 {
-    ifstream infile(filename); // open the file
-    if (!infile)
+    TRACE_SCOPE("WordCatVec::loadFromFile");
+    if (strcmp(filename, "-") == 0)
+    {
+        loadFromFd(STDIN_FILENO);
+        return;
+    }
+    int fd = open(filename, O_RDONLY | O_CLOEXEC); // open the file
+    if (fd == -1)
     {
         cout << "Failed to open file." << endl;
         return;
     }
+    try
+    {
+        loadFromFd(fd);
+    }
+    catch (const runtime_error &e) // read error part way through, keep what was loaded
+    {
+        cout << e.what() << endl;
+    }
+    close(fd);
+}
 
-    char line[256];                      // temporary array to store the line read from the file of size 256
-    WordCat *current_category = nullptr; // pointer to a WordCat object to store the current category
-
-    while (infile.getline(line, sizeof(line))) // read a line from the file
+// One pass over the file that keeps no word : each category records the byte range of its words and their stats
+// (so reporting needs no read) and reads them the first time it is used. With a log attached every word has to be logged, so the file is loaded at once.
+void WordCatVec::loadFromFileLazily(const char *filename)
+{
+    TRACE_SCOPE("WordCatVec::loadFromFileLazily");
+    if (strcmp(filename, "-") == 0 || log != nullptr) // a pipe cannot be read again later
+    {
+        loadFromFile(filename);
+        return;
+    }
+    int fd = open(filename, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        cout << "Failed to open file." << endl;
+        return;
+    }
+    shared_ptr<const string> file = make_shared<const string>(filename); // shared by every category of the file
+    WordCat current;
+    WordStats counted; // the words of current, as materialize() will load them
+    bool started = false;
+    uint64_t words_start = 0; // where the words of the current category start
+    try
     {
-        if (strlen(line) == 0)
-            continue;
-        if (line[0] == '#') // if the line starts with a '#' character, it is a category name
+        WordReader reader(fd);
+        const char *line;
+        size_t length;
+        uint64_t line_start = reader.offset();
         {
-            if (current_category)
+            TRACE_SCOPE("parse"); // load phase
+            while (reader.nextLine(line, length))
             {
-                addCategory(*current_category); // add the current category to the array
-                delete current_category;
+                if (length > 0 && line[0] == '#' && utf8Valid(line, length))
+                {
+                    if (started)
+                    {
+                        current.defer(file, words_start, line_start - words_start, counted);
+                        addCategory(move(current));
+                    }
+                    current = WordCat(Word(line + 1, length - 1));
+                    counted.clear();
+                    started = true;
+                    words_start = reader.offset();
+                }
+                else if (started && length > 0 && utf8Valid(line, length))
+                {
+                    counted.add(line, length);
+                }
+                line_start = reader.offset();
             }
-            current_category = new WordCat(line + 1); // create a new category with the name of the line without the '#' character
         }
-        else if (current_category)
+        if (started)
         {
-            current_category->insertWord(line);
+            current.defer(file, words_start, reader.offset() - words_start, counted);
+            addCategory(move(current));
         }
     }
+    catch (const runtime_error &e)
+    {
+        cout << e.what() << endl;
+    }
+    close(fd);
+}
 
-    if (current_category) // if there is a current category
+// Builder stage of the load : the reader and tokenizer threads of the pipeline run ahead while the categories are built here
+void WordCatVec::loadFromFd(int fd)
+{
+    TRACE_SCOPE("WordCatVec::loadFromFd");
+    LoadPipeline pipeline(fd);
+    LoadPipeline::Batch batch;
+    WordCat current_category;
+    WordCat::Loader loader(current_category); // each category is loaded a batch at a time, nothing is logged until addCategory
+    bool started = false;
+    while (pipeline.next(batch))
+    {
+        if (batch.kind == LoadPipeline::Batch::HEADER)
+        {
+            if (started)
+            {
+                loader.finish();
+                addCategory(move(current_category));
+            }
+            current_category = WordCat(batch.name);
+            started = true;
+        }
+        else if (started)
+        {
+            loader.add(move(batch.words));
+        }
+    }
+    if (started)
     {
-        addCategory(*current_category);
-        delete current_category;
+        loader.finish();
+        addCategory(move(current_category));
+    }
+    if (pipeline.skipped() > 0)
+    {
+        cout << "Skipped " << pipeline.skipped() << " lines that are not valid UTF-8." << endl;
     }
 }
 
 void WordCatVec::searchCategories(const char *word) const
 {
-    bool found = false;
+    TRACE_SCOPE("WordCatVec::searchCategories");
+    const vector<string> &names = categoriesContaining(word);
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        cout << "Found in category: " << names[i] << '\n';
+    }
+    if (names.empty())
+    {
+        cout << "Word not found in any category.\n";
+    }
+    cout << flush;
+}
+
+// Names of the categories holding word, in order; the menu and the server S request share the cached result
+const vector<string> &WordCatVec::categoriesContaining(const char *word) const
+{
+    TRACE_SCOPE("WordCatVec::categoriesContaining");
+    QuerySource source = {*this, QuerySource::SEARCH, word};
+    return cache.get(string("S\t") + word, source);
+}
+
+// Every word beginning with prefix, category after category (the server P request)
+const vector<string> &WordCatVec::wordsWithPrefix(const char *prefix) const
+{
+    TRACE_SCOPE("WordCatVec::wordsWithPrefix");
+    QuerySource source = {*this, QuerySource::PREFIX, prefix};
+    return cache.get(string("P\t") + prefix, source);
+}
+
+// Query cache : 12 hits, 3 misses, 3 of 256 entries
+void WordCatVec::printCacheStats() const
+{
+    cout << "Query cache : " << cache.hits() << " hits, " << cache.misses() << " misses, "
+         << cache.length() << " of " << cache.maxLength() << " entries" << endl;
+}
+
+void WordCatVec::setCacheCapacity(size_t entries)
+{
+    cache.setCapacity(entries);
+}
+
+WordStats WordCatVec::stats() const
+{
+    TRACE_SCOPE("WordCatVec::stats");
+    WordStats total;
     for (size_t i = 0; i < size; ++i)
     {
-        if (word_category[i].searchWord(word))
-        {
-            cout << "Found in category: " << word_category[i].getName() << endl;
-            found = true;
-        }
+        total += word_category[i].stats(); // not loaded() : a deferred category has the stats counted by the lazy load
+    }
+    return total;
+}
+
+// Statistics of every category, then of all of them together
+void WordCatVec::printStats() const
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        cout << "Category: " << word_category[i].c_str() << '\n';
+        word_category[i].stats().print(cout);
+        cout << "\n\n";
+    }
+    cout << "All categories:\n";
+    stats().print(cout);
+    cout << endl;
+}
+
+MemoryUsage WordCatVec::memoryUsage() const
+{
+    TRACE_SCOPE("WordCatVec::memoryUsage");
+    MemoryUsage usage;
+    // new[] of a class with a destructor stores the element count in front of the array
+    usage.addAllocation(capacity * sizeof(WordCat) + sizeof(size_t), 0, size * sizeof(WordCat) + sizeof(size_t));
+    for (size_t i = 0; i < size; ++i)
+    {
+        usage += word_category[i].memoryUsage(); // not loaded() : reporting must not read deferred categories
     }
-    if (!found)
+    return usage;
+}
+
+void WordCatVec::printMemoryUsage() const
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        cout << "Category: " << word_category[i].c_str() << "\n  ";
+        word_category[i].memoryUsage().print(cout);
+        cout << '\n';
+    }
+    MemoryUsage usage = memoryUsage();
+    cout << "All categories (" << size << " of " << capacity << " slots used):\n  ";
+    usage.print(cout);
+    cout << "\n  overhead " << usage.overhead() << " bytes for " << usage.payload << " bytes of payload" << endl;
+}
+
+void WordCatVec::shrinkToFit()
+{
+    TRACE_SCOPE("WordCatVec::shrinkToFit");
+    if (capacity > size && capacity > 1)
+    {
+        resize(size > 0 ? size : 1);
+    }
+    for (size_t i = 0; i < size; ++i)
     {
-        cout << "Word not found in any category." << endl;
+        word_category[i].shrinkToFit();
     }
 }
 
 void WordCatVec::printCategories() const
 {
+    TRACE_SCOPE("WordCatVec::printCategories");
+    // '\n' rather than endl : endl flushes cout on every line
     if (size == 0)
     {
-        cout << "No categories available." << endl;
+        cout << "No categories available.\n";
     }
     else
     {
 
         for (size_t i = 0; i < size; ++i)
         {
-            cout << "Category: " << word_category[i].getName() << endl;
-            cout << "Listing all words in that category: " << endl;
-            if (word_category[i].length() == 0)
+            cout << "Category: " << word_category[i].getName() << '\n';
+            cout << "Listing all words in that category: \n";
+            if (loaded(i).length() == 0)
             {
-                cout << " empty." << endl;
+                cout << " empty.\n";
             }
             word_category[i].printWords();
-            cout << endl; // print a new line
-            cout << endl; // print a new line
+            cout << '\n'; // print a new line
+            cout << '\n'; // print a new line
+        }
+    }
+    cout.flush();
+}
+
+void WordCatVec::exportCategories(WordExporter &out) const // writes every category, the caller decides when to finish()
+{
+    TRACE_SCOPE("WordCatVec::exportCategories");
+    for (size_t i = 0; i < size; ++i)
+    {
+        loaded(i).exportTo(out);
+    }
+}
+
+void WordCatVec::exportToFile(const char *filename, WordExporter::Format format) const
+{
+    TRACE_SCOPE("WordCatVec::exportToFile");
+    int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd == -1)
+    {
+        throw runtime_error("Failed to open file.");
+    }
+    try
+    {
+        WordExporter out(fd, format);
+        exportCategories(out);
+        out.finish();
+    }
+    catch (...)
+    {
+        close(fd);
+        throw;
+    }
+    close(fd);
+}
+
+void WordCatVec::publishShared(const char *filename) const
+{
+    TRACE_SCOPE("WordCatVec::publishShared");
+    SharedDictionary::publish(*this, filename);
+}
+
+// The categories stay in the mapped file, shared with every other process attached to it; an edit thaws a private copy
+void WordCatVec::attachShared(const char *filename)
+{
+    TRACE_SCOPE("WordCatVec::attachShared");
+    shared_ptr<const SharedDictionary> dictionary = SharedDictionary::attach(filename);
+    for (size_t n = 0; n < dictionary->length(); ++n)
+    {
+        addCategory(WordCat(dictionary->name(n), dictionary->words(n), dictionary->stats(n)));
+    }
+}
+
+bool WordCatVec::insertWord(const char *category_name, const Word &word) // false if the category does not exist
+{
+    TRACE_SCOPE("WordCatVec::insertWord");
+    WordCat *category = findCategory(category_name);
+    if (category == nullptr)
+    {
+        return false;
+    }
+    category->insertWord(word);
+    return true;
+}
+
+bool WordCatVec::insertWords(const char *category_name, vector<Word> batch, WordCat::DuplicatePolicy policy) // false if the category does not exist
+{
+    TRACE_SCOPE("WordCatVec::insertWords");
+    WordCat *category = findCategory(category_name);
+    if (category == nullptr)
+    {
+        return false;
+    }
+    category->insertWords(move(batch), policy);
+    return true;
+}
+
+bool WordCatVec::removeWord(const char *category_name, const Word &word) // false if the category or the word does not exist
+{
+    TRACE_SCOPE("WordCatVec::removeWord");
+    WordCat *category = findCategory(category_name);
+    return category != nullptr && category->removeWord(word);
+}
+
+bool WordCatVec::combineCategories(const char *first, const char *second, SetOperation operation) // false if either category does not exist
+{
+    TRACE_SCOPE("WordCatVec::combineCategories");
+    WordCat *a = findLoaded(first);
+    WordCat *b = findLoaded(second);
+    if (a == nullptr || b == nullptr)
+    {
+        return false;
+    }
+    switch (operation)
+    {
+    case UNION:
+        addCategory(a->unionWith(*b)); // a and b may move when addCategory resizes, so they are not used after
+        break;
+    case INTERSECTION:
+        addCategory(a->intersect(*b));
+        break;
+    case DIFFERENCE:
+        addCategory(a->difference(*b));
+        break;
+    case MERGE:
+        if (a != b)
+        {
+            a->merge(*b);
+            removeCategory(second);
         }
+        break;
+    }
+    return true;
+}
+
+const WordCat *WordCatVec::getCategory(const char *category_name) const
+{
+    return findLoaded(category_name);
+}
+
+WordCat *WordCatVec::getCategory(const char *category_name)
+{
+    return findLoaded(category_name);
+}
+
+void WordCatVec::attachLog(WordLog *new_log)
+{
+    log = new_log;
+    for (size_t i = 0; i < size; ++i)
+    {
+        word_category[i].attachLog(new_log);
+    }
+}
+
+void WordCatVec::commitLog()
+{
+    TRACE_SCOPE("WordCatVec::commitLog");
+    if (log == nullptr)
+    {
+        return;
+    }
+    log->commit();
+    if (log->wantsCheckpoint())
+    {
+        log->checkpoint(*this);
+    }
+}
+
+size_t WordCatVec::length() const
+{
+    return size;
+}
+
+const WordCat &WordCatVec::at(size_t n) const
+{
+    if (n >= size)
+    {
+        throw out_of_range("Index out of range");
     }
+    return loaded(n);
 }
 
 void WordCatVec::run()
@@ -186,82 +702,239 @@ void WordCatVec::run()
         cout << "6. Search all categories for a specific word\n";
         cout << "7. Show all the words starting with a given letter\n";
         cout << "8. Load from a text file\n";
+        cout << "9. Export all categories (text, csv or json)\n";
+        cout << "10. Combine two categories (union, intersection, difference or merge)\n";
+        cout << "11. Load the built-in categories\n";
+        cout << "12. Print a category page by page\n";
+        cout << "13. Show statistics\n";
+        cout << "14. Load from a text file lazily (each category is read when first used)\n";
+        cout << "15. Show memory usage\n";
+        cout << "16. Compact memory (shrink to fit)\n";
+        cout << "17. Show the first words with a prefix across all categories, sorted\n";
+        cout << "18. Show query cache statistics\n";
+        cout << "19. Publish all categories to a shared dictionary file\n";
+        cout << "20. Attach a shared dictionary file (read in place, shared between processes)\n";
         cout << "0. Exit\n";
         cout << "============================\n";
         cout << "Enter Your Choice: ";
         cin >> choice;
 
-        switch (choice)
+        try // a lazily loaded file may have gone away since, the action is dropped
         {
-        case 1:
-            printCategories();
-            break;
-        case 2:
-            char category_name[100];
-            do
+            switch (choice)
+            {
+            case 1:
+                printCategories();
+                break;
+            case 2:
+            {
+                Word category_name; // grows to fit the name typed
+                do
+                {
+                    cout << "Enter the name of the new category (or 'exit' to stop): ";
+                    cin >> category_name;
+                    addCategory(WordCat(category_name));
+                } while (strcmp(category_name.c_str(), "exit") != 0); // if the user enters 'exit', the loop will
+                break;
+            }
+            case 3:
             {
-                cout << "Enter the name of the new category (or 'exit' to stop): ";
+                Word category_name;
+                cout << "Enter the name of the category to remove: ";
                 cin >> category_name;
-                addCategory(WordCat(category_name));
-            } while (strcmp(category_name, "exit") != 0); // if the user enters 'exit', the loop will
-            break;
-        case 3:
-        {
-            char category_name[100];
-            cout << "Enter the name of the category to remove: ";
-            cin >> category_name;
-            removeCategory(category_name);
-            break;
-        }
-        case 4:
-        {
-            char category_name[256];
-            cout << "Enter the name of the category to clear: ";
-            cin.ignore();
-            cin.getline(category_name, 256);
-            clearCategory(category_name);
-            break;
-        }
-        case 5:
-        {
-            char category_name[256];
-            cout << "Enter the name of the category to modify: ";
-            cin.ignore();
-            cin.getline(category_name, 256);
-            modifyCategory(category_name);
-            break;
-        }
-        case 6:
-        {
-            char word[256];
-            cout << "Enter the word to search for: ";
-            cin.ignore();
-            cin.getline(word, 256);
-            searchCategories(word);
-            break;
-        }
-        case 7:
-        {
-            char letter;
-            cout << "Enter the first letter of the words to show: ";
-            cin >> letter;
-            showWordsStartingWith(letter);
-            break;
+                removeCategory(category_name.c_str());
+                break;
+            }
+            case 4:
+            {
+                char category_name[256];
+                cout << "Enter the name of the category to clear: ";
+                cin.ignore();
+                cin.getline(category_name, 256);
+                clearCategory(category_name);
+                break;
+            }
+            case 5:
+            {
+                char category_name[256];
+                cout << "Enter the name of the category to modify: ";
+                cin.ignore();
+                cin.getline(category_name, 256);
+                modifyCategory(category_name);
+                break;
+            }
+            case 6:
+            {
+                char word[256];
+                cout << "Enter the word to search for: ";
+                cin.ignore();
+                cin.getline(word, 256);
+                searchCategories(word);
+                break;
+            }
+            case 7:
+            {
+                Word letter; // one character, but it can take several bytes in UTF-8
+                cout << "Enter the first letter of the words to show: ";
+                cin >> letter;
+                showWordsStartingWith(letter.c_str());
+                break;
+            }
+            case 8:
+            {
+                char filename[256];
+                cout << "Enter the name of the file to load: ";
+                cin.ignore();
+                cin.getline(filename, 256);
+                loadFromFile(filename);
+                break;
+            }
+            case 9:
+            {
+                Word filename;
+                Word format_name;
+                WordExporter::Format format;
+                cout << "Enter the name of the file to export to: ";
+                cin >> filename;
+                cout << "Enter the format (text, csv or json): ";
+                cin >> format_name;
+                if (!WordExporter::parseFormat(format_name.c_str(), format))
+                {
+                    cout << "Unknown format." << endl;
+                    break;
+                }
+                try
+                {
+                    exportToFile(filename.c_str(), format);
+                }
+                catch (const runtime_error &e)
+                {
+                    cout << e.what() << endl;
+                }
+                break;
+            }
+            case 10:
+            {
+                char first[256];
+                char second[256];
+                int operation;
+                cout << "Enter the name of the first category: ";
+                cin.ignore();
+                cin.getline(first, 256);
+                cout << "Enter the name of the second category: ";
+                cin.getline(second, 256);
+                cout << "1. Union  2. Intersection  3. Difference (first - second)  4. Merge second into first\n";
+                cout << "Enter the operation: ";
+                cin >> operation;
+                if (operation < 1 || operation > 4)
+                {
+                    cout << "Invalid choice. Please try again." << endl;
+                    break;
+                }
+                if (!combineCategories(first, second, static_cast<SetOperation>(operation - 1)))
+                {
+                    cout << "Category not found." << endl;
+                }
+                break;
+            }
+            case 11:
+                loadBuiltinCategories();
+                cout << "Built-in categories loaded." << endl;
+                break;
+            case 12:
+            {
+                char name[256];
+                size_t page_size;
+                cout << "Enter the name of the category: ";
+                cin.ignore();
+                cin.getline(name, 256);
+                const WordCat *category = findLoaded(name);
+                if (category == nullptr)
+                {
+                    cout << "Category not found." << endl;
+                    break;
+                }
+                cout << "Enter the number of words per page: ";
+                if (cin >> page_size && page_size > 0)
+                {
+                    category->printWordsByPage(page_size);
+                }
+                else
+                {
+                    cout << "Invalid page size." << endl;
+                }
+                break;
+            }
+            case 13:
+                printStats();
+                break;
+            case 14:
+            {
+                char filename[256];
+                cout << "Enter the name of the file to load: ";
+                cin.ignore();
+                cin.getline(filename, 256);
+                loadFromFileLazily(filename);
+                break;
+            }
+            case 15:
+                printMemoryUsage();
+                break;
+            case 16:
+                shrinkToFit();
+                printMemoryUsage();
+                break;
+            case 17:
+            {
+                Word prefix;
+                size_t limit;
+                cout << "Enter the prefix: ";
+                cin >> prefix;
+                cout << "Enter how many words to show: ";
+                cin >> limit;
+                if (printSortedWithPrefix(prefix.c_str(), limit, cout) == 0)
+                {
+                    cout << "No words found." << endl;
+                }
+                break;
+            }
+            case 18:
+                printCacheStats();
+                break;
+            case 19:
+            case 20:
+            {
+                Word filename;
+                cout << "Enter the name of the shared dictionary file: ";
+                cin >> filename;
+                try
+                {
+                    if (choice == 19)
+                    {
+                        publishShared(filename.c_str());
+                    }
+                    else
+                    {
+                        attachShared(filename.c_str());
+                    }
+                }
+                catch (const runtime_error &e)
+                {
+                    cout << e.what() << endl;
+                }
+                break;
+            }
+            case 0:
+                cout << "Goodbye!" << endl;
+                break;
+            default:
+                cout << "Invalid choice. Please try again." << endl;
+            }
         }
-        case 8:
+        catch (const runtime_error &e)
         {
-            char filename[256];
-            cout << "Enter the name of the file to load: ";
-            cin.ignore();
-            cin.getline(filename, 256);
-            loadFromFile(filename);
-            break;
-        }
-        case 0:
-            cout << "Goodbye!" << endl;
-            break;
-        default:
-            cout << "Invalid choice. Please try again." << endl;
+            cout << e.what() << endl;
         }
+        commitLog(); // one write and one sync for all the edits of the action
     } while (choice != 0);
 }
@@ -2,30 +2,79 @@
 #define WORDCATVEC_H
 
 #include "WordCat.h"
+#include "QueryCache.h"
 #include <iostream>
 #include <stdexcept>
 
+class WordLog;
+
 class WordCatVec
 {
 private:
     WordCat *word_category;
     size_t capacity; // number of categories that can be stored
     size_t size;     // number of categories
+    WordLog *log;    // not owned, nullptr unless attachLog() was called
+    mutable QueryCache cache; // results of categoriesContaining, wordsWithPrefix and showWordsStartingWith
+
+    struct QuerySource; // the categories as the cache sees them, for one query
 
     void resize(size_t new_capacity);
+    WordCat *findCategory(const char *category_name) const;
+    WordCat *findLoaded(const char *category_name) const; // findCategory, then materialize : throws runtime_error if the file cannot be read
+    WordCat &loaded(size_t n) const;                        // n'th category, materialized first (throws the same way)
 
 public:
+    enum SetOperation
+    {
+        UNION,        // new category with the words of either
+        INTERSECTION, // new category with the words of both
+        DIFFERENCE,   // new category with the words of the first only
+        MERGE         // the second category is moved into the first and removed
+    };
+
     WordCatVec();
     ~WordCatVec();
 
     void addCategory(const WordCat &category);
+    void addCategory(WordCat &&category);
+    void addStaticCategories(const StaticCategory *tables, size_t count); // skips names that already exist
+    size_t addMissingCategories(const WordCatVec &other);                 // copies of the categories of other whose name is not here, returns how many
+    void loadBuiltinCategories();                                        // the tables compiled in from A1_dictionary.h
     void removeCategory(const char *category_name);
     void clearCategory(const char *category_name);
     void modifyCategory(const char *category);
     void searchCategories(const char *word) const;
+    const std::vector<std::string> &categoriesContaining(const char *word) const; // names, in order, cached; valid until the next query
+    const std::vector<std::string> &wordsWithPrefix(const char *prefix) const;    // cached the same way
     void showWordsStartingWith(char letter) const;
-    void loadFromFile(const char *filename);
+    void showWordsStartingWith(const char *letter) const; // letter is UTF-8, the comparison ignores case
+    size_t printSortedWithPrefix(const char *prefix, size_t limit, std::ostream &os) const; // first limit words of all categories in sorted order, "word<TAB>category" lines
+    void loadFromFile(const char *filename); // "-" reads standard input
+    void loadFromFd(int fd);
+    void loadFromFileLazily(const char *filename); // only the headers are read now, each category on first use
     void printCategories() const;
+    void exportCategories(WordExporter &out) const;
+    void exportToFile(const char *filename, WordExporter::Format format) const;
+    void publishShared(const char *filename) const; // every category into a SharedDictionary file, throws runtime_error
+    void attachShared(const char *filename);        // adds the categories of a SharedDictionary file, read in place
+    bool insertWord(const char *category_name, const Word &word);
+    bool insertWords(const char *category_name, std::vector<Word> batch, WordCat::DuplicatePolicy policy = WordCat::KEEP_DUPLICATES);
+    bool removeWord(const char *category_name, const Word &word);
+    bool combineCategories(const char *first, const char *second, SetOperation operation);
+    const WordCat *getCategory(const char *category_name) const; // nullptr if there is no such category
+    WordCat *getCategory(const char *category_name);
+    size_t length() const;               // number of categories
+    WordStats stats() const;             // all categories together, one sum per category
+    void printStats() const;
+    MemoryUsage memoryUsage() const; // the array of categories (spare slots as unused) and every category in it
+    void printMemoryUsage() const;
+    void shrinkToFit(); // no spare slots, every category compacted
+    void printCacheStats() const;
+    void setCacheCapacity(size_t entries); // 0 turns the query cache off
+    const WordCat &at(size_t n) const;   // n'th category, throws out_of_range
+    void attachLog(WordLog *log); // every later edit is appended to log, nullptr stops logging
+    void commitLog();             // makes the edits so far durable, checkpoints when the log has grown long
     void run();
 };
 
@@ -0,0 +1,273 @@
+#include "WordExporter.h"
+#include <stdexcept> // runtime_error
+#include <cerrno>
+#include <cstring>
+#include <unistd.h> // write
+using namespace std;
+
+// Constructor : WordExporter out(fd, WordExporter::CSV); the fd stays owned by the caller
+WordExporter::WordExporter(int fd, Format format, size_t buffer_size)
+    : fd(fd), os(nullptr), format(format), buffer(new char[buffer_size]), capacity(buffer_size), used(0),
+      category(nullptr), category_length(0), categories(0), words(0), finished(false)
+{
+    if (format == CSV)
+    {
+        put("category,word\n", 14);
+    }
+    else if (format == JSON)
+    {
+        put('{');
+    }
+}
+
+// Constructor : WordExporter out(cout, WordExporter::JSON);
+WordExporter::WordExporter(ostream &os, Format format, size_t buffer_size) : WordExporter(-1, format, buffer_size)
+{
+    this->os = &os;
+}
+
+WordExporter::~WordExporter()
+{
+    if (!finished)
+    {
+        try
+        {
+            finish();
+        }
+        catch (...) // a destructor must not throw, call finish() directly to see write errors
+        {
+        }
+    }
+    delete[] buffer;
+}
+
+// Append one byte, writing the buffer out first if it is full
+inline void WordExporter::put(char c)
+{
+    if (used == capacity)
+    {
+        flush();
+    }
+    buffer[used++] = c;
+}
+
+// Append length bytes, in buffer sized pieces if the data is larger than the free space
+void WordExporter::put(const char *data, size_t length)
+{
+    while (length > 0)
+    {
+        if (used == capacity)
+        {
+            flush();
+        }
+        size_t chunk = capacity - used < length ? capacity - used : length;
+        memcpy(buffer + used, data, chunk);
+        used += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+// CSV field : quoted only if it contains a comma, a quote or a line break, quotes are doubled
+void WordExporter::putCsvField(const char *data, size_t length)
+{
+    bool quote = false;
+    for (size_t i = 0; i < length && !quote; ++i)
+    {
+        quote = data[i] == ',' || data[i] == '"' || data[i] == '\r' || data[i] == '\n';
+    }
+    if (!quote)
+    {
+        put(data, length);
+        return;
+    }
+    put('"');
+    for (size_t i = 0; i < length; ++i)
+    {
+        if (data[i] == '"')
+        {
+            put('"');
+        }
+        put(data[i]);
+    }
+    put('"');
+}
+
+// JSON string : escapes quotes, backslashes and control characters, everything else (UTF-8 included) is copied as is
+void WordExporter::putJsonString(const char *data, size_t length)
+{
+    static const char hex[] = "0123456789abcdef";
+    put('"');
+    size_t plain = 0; // start of the run of bytes that need no escaping
+    for (size_t i = 0; i < length; ++i)
+    {
+        unsigned char c = data[i];
+        if (c >= 0x20 && c != '"' && c != '\\')
+        {
+            continue;
+        }
+        put(data + plain, i - plain); // copy the run before the special character in one piece
+        put('\\');
+        switch (c)
+        {
+        case '"':
+            put('"');
+            break;
+        case '\\':
+            put('\\');
+            break;
+        case '\n':
+            put('n');
+            break;
+        case '\t':
+            put('t');
+            break;
+        case '\r':
+            put('r');
+            break;
+        default: // other control characters : \u00XX
+            put("u00", 3);
+            put(hex[c >> 4]);
+            put(hex[c & 0xF]);
+            break;
+        }
+        plain = i + 1;
+    }
+    put(data + plain, length - plain);
+    put('"');
+}
+
+void WordExporter::beginCategory(const char *name)
+{
+    category = name;
+    category_length = strlen(name);
+    words = 0;
+    switch (format)
+    {
+    case TEXT:
+        put('#');
+        put(name, category_length);
+        put('\n');
+        break;
+    case CSV:
+        break; // the name is repeated on every row
+    case JSON:
+        if (categories > 0)
+        {
+            put(',');
+        }
+        put('\n');
+        putJsonString(name, category_length);
+        put(": [", 3);
+        break;
+    }
+    ++categories;
+}
+
+void WordExporter::word(const char *word, size_t length)
+{
+    switch (format)
+    {
+    case TEXT:
+        put(word, length);
+        put('\n');
+        break;
+    case CSV:
+        putCsvField(category, category_length);
+        put(',');
+        putCsvField(word, length);
+        put('\n');
+        break;
+    case JSON:
+        if (words > 0)
+        {
+            put(", ", 2);
+        }
+        putJsonString(word, length);
+        break;
+    }
+    ++words;
+}
+
+void WordExporter::word(const Word &word)
+{
+    this->word(word.c_str(), word.length());
+}
+
+void WordExporter::endCategory()
+{
+    if (format == JSON)
+    {
+        put(']');
+    }
+    category = nullptr;
+    category_length = 0;
+}
+
+void WordExporter::finish()
+{
+    if (finished)
+    {
+        return;
+    }
+    finished = true;
+    if (format == JSON)
+    {
+        put("\n}\n", 3);
+    }
+    flush();
+    if (os != nullptr)
+    {
+        os->flush(); // the single flush of the export
+    }
+}
+
+// Write the whole buffer out and make it empty again
+void WordExporter::flush()
+{
+    size_t written = 0;
+    if (os != nullptr)
+    {
+        os->write(buffer, used);
+        if (!*os)
+        {
+            throw runtime_error("Failed to write export.");
+        }
+        written = used;
+    }
+    while (written < used) // write() may accept less than asked for
+    {
+        ssize_t n = ::write(fd, buffer + written, used - written);
+        if (n == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw runtime_error(string("Failed to write export: ") + strerror(errno));
+        }
+        written += n;
+    }
+    used = 0;
+}
+
+bool WordExporter::parseFormat(const char *name, Format &format)
+{
+    if (strcmp(name, "text") == 0)
+    {
+        format = TEXT;
+    }
+    else if (strcmp(name, "csv") == 0)
+    {
+        format = CSV;
+    }
+    else if (strcmp(name, "json") == 0)
+    {
+        format = JSON;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,60 @@
+#ifndef WORDEXPORTER_H
+#define WORDEXPORTER_H
+
+#include "Word.h"
+#include <iostream>
+
+// Streams categories out as plain text, CSV or JSON through one large buffer that is reused for the whole export.
+// Nothing is formatted into intermediate strings : every byte is appended straight to the buffer,
+// and the buffer is written to the file descriptor / stream only when it is full and once more in finish().
+//
+//   TEXT : the same format loadFromFile reads ("#category" line, then one word per line)
+//   CSV  : "category,word" header, one row per word, fields quoted when needed
+//   JSON : {"category": ["word", ...], ...}
+class WordExporter
+{
+public:
+    enum Format
+    {
+        TEXT,
+        CSV,
+        JSON
+    };
+
+    static const size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    WordExporter(int fd, Format format, size_t buffer_size = DEFAULT_BUFFER_SIZE);
+    WordExporter(std::ostream &os, Format format, size_t buffer_size = DEFAULT_BUFFER_SIZE);
+    WordExporter(const WordExporter &) = delete;
+    WordExporter &operator=(const WordExporter &) = delete;
+    ~WordExporter(); // calls finish() if it was not called
+
+    void beginCategory(const char *name);
+    void word(const char *word, size_t length);
+    void word(const Word &word);
+    void endCategory();
+    void finish(); // closes the document and writes whatever is left in the buffer
+
+    static bool parseFormat(const char *name, Format &format); // "text", "csv" or "json"
+
+private:
+    int fd;           // -1 when writing to a stream
+    std::ostream *os; // nullptr when writing to a file descriptor
+    Format format;
+    char *buffer;
+    size_t capacity;
+    size_t used;
+    const char *category;   // name of the open category, needed by CSV rows
+    size_t category_length; //
+    size_t categories;      // categories written so far (JSON separators)
+    size_t words;           // words written in the open category (JSON separators)
+    bool finished;
+
+    void put(char c);
+    void put(const char *data, size_t length);
+    void putCsvField(const char *data, size_t length);
+    void putJsonString(const char *data, size_t length);
+    void flush();
+};
+
+#endif // WORDEXPORTER_H
@@ -4,20 +4,79 @@
 #include "Word.h"
 #include <stdexcept>
 #include <iostream>
+#include <memory> // allocator, allocator_traits
+#include <string>
+#include <cctype> // tolower
 using namespace std;
 
-class WordList
+// Default ordering policy : strcmp order through Word's operators, and Word's hash for the index.
+// An ordering policy gives the list three things that must agree with each other :
+//   operator()(a, b) : a sorts before b
+//   equal(a, b)      : a and b are the same word (one call, not two operator() calls)
+//   hash(a)          : equal words hash the same, used by the hash index
+struct WordOrder
+{
+    bool operator()(const Word &a, const Word &b) const { return a < b; }
+    bool equal(const Word &a, const Word &b) const { return a == b; }
+    uint64_t hash(const Word &word) const { return word.hash(); }
+};
+
+// Ordering policy that ignores ASCII case : "Cat" and "cat" are the same word, "apple" < "Banana" < "cherry".
+// Bytes of multi-byte UTF-8 characters are compared as they are.
+// BasicWordList<Word, CaseFoldedOrder> list; list.enableCounts(); then "Cat" and "cat" are one word counted twice
+struct CaseFoldedOrder
+{
+    static int compare(const Word &a, const Word &b)
+    {
+        const unsigned char *x = reinterpret_cast<const unsigned char *>(a.c_str());
+        const unsigned char *y = reinterpret_cast<const unsigned char *>(b.c_str());
+        for (; *x != '\0' && tolower(*x) == tolower(*y); ++x, ++y)
+        {
+        }
+        return tolower(*x) - tolower(*y);
+    }
+    bool operator()(const Word &a, const Word &b) const { return compare(a, b) < 0; }
+    bool equal(const Word &a, const Word &b) const { return a.length() == b.length() && compare(a, b) == 0; }
+    uint64_t hash(const Word &word) const
+    {
+        string folded(word.c_str(), word.length());
+        for (size_t i = 0; i < folded.size(); ++i)
+        {
+            folded[i] = static_cast<char>(tolower(static_cast<unsigned char>(folded[i])));
+        }
+        return Word::hash(folded.data(), folded.size());
+    }
+};
+
+// Heap owned by one element, for bytes() and memoryUsage() : overload these for an element type that allocates
+template <class T>
+size_t heapBytes(const T &) { return 0; }
+inline size_t heapBytes(const Word &word) { return word.length() + 1; }
+template <class T>
+MemoryUsage heapUsage(const T &) { return MemoryUsage(); }
+inline MemoryUsage heapUsage(const Word &word) { return word.memoryUsage(); }
+
+// Sorted doubly linked list of T, with an optional hash index and an optional multiset mode.
+// The element type, the ordering policy and the allocator are template parameters, so another configuration
+// (interned ids, CaseFoldedOrder, an arena) gets its comparisons and allocations inlined, with no virtual call.
+// The members are defined in WordList.ipp, included below, so any configuration can be used without listing it anywhere.
+// The per-word members (push, pop, insertSorted, remove, lookup, count) are not traced; only the bulk ones are.
+// merge() relinks nodes, so both lists must use equal allocators.
+template <class T, class Compare = WordOrder, class Allocator = std::allocator<T> >
+class BasicWordList
 {
 private:
     struct Node
     {
-        Word word;
+        T word;
         Node *next;
         Node *prev;
+        uint64_t hash; // order.hash(word), only filled in while the list is indexed
+        size_t count;  // occurrences of word, more than 1 only while the list counts duplicates
 
         // Constructors for Node
-        Node(const Word &aword, Node *next = nullptr, Node *prev = nullptr)
-            : word(aword), next(next), prev(prev) {}
+        Node(const T &aword, Node *next = nullptr, Node *prev = nullptr)
+            : word(aword), next(next), prev(prev), hash(0), count(1) {}
 
         Node() = delete;
         Node(const Node &) = delete;
@@ -27,36 +86,109 @@ private:
         ~Node() = default;
     };
 
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node> NodeAllocator;
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node *> TableAllocator;
+    typedef std::allocator_traits<NodeAllocator> NodeTraits;
+    typedef std::allocator_traits<TableAllocator> TableTraits;
+
     Node *head;
     Node *tail;
-    size_t size;
+    size_t size;        // nodes
+    size_t word_count; // words, the counts of every node added up
+    bool counting;      // multiset mode : one node per distinct word with a count, instead of one node per word
+
+    // Optional hash index : open addressing with linear probing, one slot per node, capacity a power of two
+    Node **table;
+    size_t table_capacity;
+    bool indexed;
 
-    Node *search(const Word &word) const;
+    Compare order;
+    NodeAllocator node_allocator;
+    TableAllocator table_allocator;
+
+    Node *newNode(const T &word, Node *next, Node *prev);
+    void deleteNode(Node *node);
+    void freeTable();
+    Node *search(const T &word) const;
     Node *getWord(int n) const;
+    void indexInsert(Node *node); // called before size counts the new node
+    void indexErase(Node *node);
+    void rehash(size_t new_capacity);
+    void unlink(Node *node); // takes the node out of the list and its table, then frees it
 
 public:
-    WordList();
-    WordList(const WordList &other);
-    WordList(WordList &&other) noexcept;
-    WordList &operator=(const WordList &other);
-    WordList &operator=(WordList &&other) noexcept;
-    ~WordList();
-
-    size_t length() const;
+    typedef T value_type;
+
+    // Read-only forward iterator : for (WordList::const_iterator it = list.begin(); it != list.end(); ++it)
+    // A counted word is handed out count times, so a walk sees the same words whether duplicates are counted or not
+    class const_iterator
+    {
+    private:
+        const Node *node;
+        size_t repeat; // copies of node->word already handed out
+        explicit const_iterator(const Node *node) : node(node), repeat(0) {}
+        friend class BasicWordList;
+
+    public:
+        const_iterator() : node(nullptr), repeat(0) {}
+        const T &operator*() const { return node->word; }
+        const T *operator->() const { return &node->word; }
+        const_iterator &operator++()
+        {
+            if (++repeat == node->count)
+            {
+                node = node->next;
+                repeat = 0;
+            }
+            return *this;
+        }
+        bool operator==(const const_iterator &other) const { return node == other.node && repeat == other.repeat; }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+    };
+
+    BasicWordList();
+    explicit BasicWordList(const Allocator &allocator); // nodes and table come from allocator (e.g. an arena)
+    BasicWordList(const BasicWordList &other);
+    BasicWordList(BasicWordList &&other) noexcept;
+    BasicWordList &operator=(const BasicWordList &other);
+    BasicWordList &operator=(BasicWordList &&other) noexcept;
+    ~BasicWordList();
+
+    size_t length() const;      // nodes : distinct words while counting
+    size_t occurrences() const; // every word, duplicates included
     bool isEmpty() const;
-    Word &front();
-    Word &back();
-    void push_front(const Word &word);
-    void push_back(const Word &word);
-    Word pop_front();
-    Word pop_back();
-    void insertSorted(const Word &word);
-    bool remove(const Word &word);
-    Word fetchWord(int index) const;
+    T &front();
+    T &back();
+    void push_front(const T &word);
+    void push_back(const T &word);
+    T pop_front();
+    T pop_back();
+    void insertSorted(const T &word);
+    bool remove(const T &word); // one occurrence
+    size_t count(const T &word) const;
+    T fetchWord(int index) const;
     void print(ostream &os, int n = 5) const;
-    bool lookup(const Word &word) const;
-
-    friend ostream &operator<<(ostream &os, const WordList &list);
+    bool lookup(const T &word) const;
+    const_iterator find(const T &word) const; // first copy of word, end() if there is none : one probe when indexed, a walk otherwise
+    void merge(BasicWordList &other); // moves every node of the sorted list other into this sorted list, other ends up empty
+    void clear();                // removes every word, keeps the index setting
+    void enableIndex(bool enable = true); // keep a hash table from word to node : O(1) expected lookup and remove
+    bool hasIndex() const;
+    void enableCounts(bool enable = true); // multiset mode : duplicates of a sorted list are folded into counts (or split back)
+    bool hasCounts() const;
+    size_t bytes() const; // heap bytes used by the nodes, the characters and the hash table
+    MemoryUsage memoryUsage() const;
+    void shrinkToFit(); // smallest hash table that keeps the load under 70%
+    const_iterator begin() const;
+    const_iterator end() const;
 };
 
+template <class T, class Compare, class Allocator>
+ostream &operator<<(ostream &os, const BasicWordList<T, Compare, Allocator> &list);
+
+// Today's list : Words in strcmp order, nodes from std::allocator
+typedef BasicWordList<Word> WordList;
+
+#include "WordList.ipp"
+
 #endif // WORDLIST_H
@@ -0,0 +1,782 @@
+// Member definitions of BasicWordList, included at the end of WordList.h so every configuration is compiled where it is used
+#include "Trace.h"
+#include <algorithm> // fill
+
+// Default constructor : WordList list; initializing head and tail to nullptr and size to 0. This is an empty list.
+template <class T, class Compare, class Allocator>
+BasicWordList<T, Compare, Allocator>::BasicWordList() : head(nullptr), tail(nullptr), size(0), word_count(0), counting(false), table(nullptr), table_capacity(0), indexed(false) {}
+
+// Constructor : WordList list(allocator); an empty list whose nodes and hash table come from allocator
+template <class T, class Compare, class Allocator>
+BasicWordList<T, Compare, Allocator>::BasicWordList(const Allocator &allocator)
+    : head(nullptr), tail(nullptr), size(0), word_count(0), counting(false), table(nullptr), table_capacity(0), indexed(false),
+      node_allocator(allocator), table_allocator(allocator) {}
+
+// Copy constructor : WordList list1(list2); &other here is a reference to list2, so we are copying the head, tail, and size of list2 into the NEW head, tail, and size variables of list1
+template <class T, class Compare, class Allocator>
+BasicWordList<T, Compare, Allocator>::BasicWordList(const BasicWordList &other)
+    : BasicWordList(Allocator(other.node_allocator)) // calls the allocator constructor to initialize the new list, with the same allocator
+{
+    indexed = other.indexed; // the copy is indexed too, push_back fills its table
+    for (Node *node = other.head; node != nullptr; node = node->next) // starts at the head of the other list, goes through each node (node = node->next is the expression that is executed after each iteration of the loop. It moves the node pointer to the next node in the list) till nullptr
+    {
+        push_back(node->word); // uses the push_back function to add the word from the other list to the new list
+        tail->count = node->count;
+        word_count += node->count - 1;
+    }
+    counting = other.counting; // only now, so push_back above copies the nodes one for one
+    order = other.order;
+}
+
+// Move constructor : WordList list1(move(list2)); && is an rvalue reference == binds to a temporary value that will be destroyed after the move constructor is called (means list2 will be destroyed after the move constructor is called)
+template <class T, class Compare, class Allocator>
+BasicWordList<T, Compare, Allocator>::BasicWordList(BasicWordList &&other) noexcept : head(other.head), tail(other.tail), size(other.size), // head, tail, and size of the new list (list1) are set to the head, tail, and size of the other list (list2)
+                                                           word_count(other.word_count), counting(other.counting),
+                                                           table(other.table), table_capacity(other.table_capacity), indexed(other.indexed),
+                                                           order(other.order), node_allocator(move(other.node_allocator)), table_allocator(move(other.table_allocator))
+{
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+    other.word_count = 0;
+    other.table = nullptr;
+    other.table_capacity = 0;
+}
+
+// Copy assignment operator : WordList list1 = list2;
+template <class T, class Compare, class Allocator>
+BasicWordList<T, Compare, Allocator> &BasicWordList<T, Compare, Allocator>::operator=(const BasicWordList &other)
+{
+    if (this != &other) // if list 1 is not list 2
+    {
+        BasicWordList copy = other; // create a list called copy that holds the other list / list 2
+        swap(*this, copy);     // insert list 2 into list 1
+    }
+    return *this; // return list 1
+}
+
+// Move assignment operator : WordList list1 = move(list2);
+template <class T, class Compare, class Allocator>
+BasicWordList<T, Compare, Allocator> &BasicWordList<T, Compare, Allocator>::operator=(BasicWordList &&other) noexcept
+{
+    if (this != &other) // if list 1 is not list 2
+    {
+        swap(head, other.head); // swap the head of list 1 with the head of list 2
+        swap(tail, other.tail);
+        swap(size, other.size);
+        swap(word_count, other.word_count);
+        swap(counting, other.counting);
+        swap(table, other.table);
+        swap(table_capacity, other.table_capacity);
+        swap(indexed, other.indexed);
+        swap(order, other.order);
+        swap(node_allocator, other.node_allocator); // the nodes go with the allocator they came from
+        swap(table_allocator, other.table_allocator);
+    }
+    return *this; // return list 1
+}
+
+// Destructor
+template <class T, class Compare, class Allocator>
+BasicWordList<T, Compare, Allocator>::~BasicWordList()
+{
+    clear();
+}
+
+// Every node comes from node_allocator : allocate, then construct the node in place
+template <class T, class Compare, class Allocator>
+typename BasicWordList<T, Compare, Allocator>::Node *BasicWordList<T, Compare, Allocator>::newNode(const T &word, Node *next, Node *prev)
+{
+    Node *node = NodeTraits::allocate(node_allocator, 1);
+    try
+    {
+        NodeTraits::construct(node_allocator, node, word, next, prev);
+    }
+    catch (...)
+    {
+        NodeTraits::deallocate(node_allocator, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::deleteNode(Node *node)
+{
+    NodeTraits::destroy(node_allocator, node);
+    NodeTraits::deallocate(node_allocator, node, 1);
+}
+
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::freeTable()
+{
+    if (table != nullptr)
+    {
+        TableTraits::deallocate(table_allocator, table, table_capacity);
+    }
+    table = nullptr;
+    table_capacity = 0;
+}
+
+// Remove every word : WordList list; list.clear();
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::clear()
+{
+    TRACE_SCOPE("WordList::clear");
+    Node *node = head;
+    while (node != nullptr) // no need to unlink one by one, every node goes
+    {
+        Node *next = node->next;
+        deleteNode(node);
+        node = next;
+    }
+    head = nullptr;
+    tail = nullptr;
+    size = 0;
+    word_count = 0;
+    freeTable();
+}
+
+// Return the length of the list
+template <class T, class Compare, class Allocator>
+size_t BasicWordList<T, Compare, Allocator>::length() const
+{
+    return size;
+}
+
+// Check if the list is empty
+template <class T, class Compare, class Allocator>
+bool BasicWordList<T, Compare, Allocator>::isEmpty() const
+{
+    return size == 0; // if size is 0, then give true (empty), else give false (not empty)
+}
+
+// Return the first word in the list
+template <class T, class Compare, class Allocator>
+T &BasicWordList<T, Compare, Allocator>::front()
+{
+    if (isEmpty())
+    {
+        throw std::runtime_error("List is empty");
+    }
+    return head->word; // return word member of the head node
+}
+
+// Return the last word in the list
+template <class T, class Compare, class Allocator>
+T &BasicWordList<T, Compare, Allocator>::back()
+{
+    if (isEmpty())
+    {
+        throw std::runtime_error("List is empty");
+    }
+    return tail->word; // return word member of the tail node
+}
+
+// Add a word to the front of the list
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::push_front(const T &word)
+{
+    word_count++;
+    if (counting && head != nullptr && order.equal(head->word, word)) // multiset mode : one more of the first word
+    {
+        head->count++;
+        return;
+    }
+    Node *node = newNode(word, head, nullptr);
+    indexInsert(node);
+    if (head != nullptr) // if the head is not nullptr, which means the list is not empty
+    {
+        head->prev = node; // the previous of the current head node is set to the new node
+    }
+    head = node;         // else, the head pointer of the list is updated to the new node
+    if (tail == nullptr) // if the list is empty
+    {
+        tail = node; // tail is set to the new node
+                     // this means both head and tail are pointing to the new node, as it is the only node in the list
+    }
+    size++; // increment the size of the list
+}
+
+// Add a word to the back of the list
+// eg. list.push_back(Word("dog")); // add at the end
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::push_back(const T &word)
+{
+    word_count++;
+    if (counting && tail != nullptr && order.equal(tail->word, word)) // multiset mode : one more of the last word
+    {
+        tail->count++;
+        return;
+    }
+    Node *node = newNode(word, nullptr, tail); // (the word new node will hold, next node set null here because will be the last pointer, previous node will be set to the current tail node)
+    indexInsert(node);
+    if (tail != nullptr)                        // if the tail is not nullptr, which means the list is not empty
+    {
+        tail->next = node; // -> accesses the member of the object pointing (accesses the next pointer of the tail node and sets it to the new node). New node becomes end of the list.
+                           // For example, if you have a pointer p that points to an object of a class that has a member m, you can access m through p using the -> operator like this: p->m.
+    }
+    tail = node;         // else, the tail pointer of the list is updated to the new node, as the new node is now the last node in the list.
+    if (head == nullptr) // if the list is empty
+    {
+        head = node; // head is set to the new node
+                     // this means both head and tail are pointing to the new node, as it is the only node in the list
+    }
+    size++; // increment the size of the list
+}
+
+// Remove and return the first word in the list
+template <class T, class Compare, class Allocator>
+T BasicWordList<T, Compare, Allocator>::pop_front()
+{
+    if (isEmpty())
+    {
+        throw std::runtime_error("List is empty");
+    }
+    word_count--;
+    if (head->count > 1) // a counted word : one copy goes, the node stays
+    {
+        head->count--;
+        return head->word;
+    }
+    Node *node = head;      // creates a pointer node that points to the first node in the list (head)
+    indexErase(node);
+    T word = node->word; // creates a word object that holds the word of the first node since we wil be deleting the node !!
+    head = node->next;      // updates the head pointer to the next node in the list
+                            // this means the first node is no longer in the list
+    if (head != nullptr)    // If the list is not empty after removing the first node
+    {
+        head->prev = nullptr; // this line sets the prev pointer of the new first node to nullptr
+    }
+    else
+    {
+        tail = nullptr; // tail is set to nullptr as there are no nodes in the list
+    }
+    deleteNode(node); // deletes the first node
+    size--;      // decrements the size of the list
+    return word; // returns the word that was in the first node
+}
+
+// Remove and return the last word in the list
+template <class T, class Compare, class Allocator>
+T BasicWordList<T, Compare, Allocator>::pop_back()
+{
+    if (isEmpty())
+    {
+        throw std::runtime_error("List is empty");
+    }
+    word_count--;
+    if (tail->count > 1)
+    {
+        tail->count--;
+        return tail->word;
+    }
+    Node *node = tail;      // create a pointer node that points to the last node in the list (tail)
+    indexErase(node);
+    T word = node->word; // grab the word from the last node
+    tail = node->prev;      // the previous node becomes the new tail effectively removing the last node
+    if (tail != nullptr)    // if list not empty
+    {
+        tail->next = nullptr; // next of this new tail is set to nullptr
+    }
+    else
+    {
+        head = nullptr; // if list is empty, head is set to nullptr
+    }
+    deleteNode(node); // can now delete the last node
+    size--;
+    return word;
+}
+
+// Insert a word in sorted order : WordList list; list.insertSorted(Word("cat"));
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::insertSorted(const T &word)
+{
+    if (isEmpty() || !order(head->word, word)) // if the list is empty or the word is less than or equal to the first word in the list
+    {
+        push_front(word); // add the word to the front of the list
+    }
+    else if (!order(word, tail->word)) // if the word is greater than or equal to the last word in the list
+    {
+        push_back(word);
+    }
+    else // if the word is in the middle of the list
+    {
+        Node *current = head;                                          // new node current is set to the head of the list
+        while (current->next != nullptr && order(current->next->word, word)) // loop that while not at end of list and word we want to insert is greater than the current word
+        {
+            current = current->next; // move to the current pointer to the next node
+                                     // So when the loop stops, current points to the node whose word is less than the word to be inserted. The next node (current->next) is the first node whose word is not less than the word to be inserted.
+        }
+        word_count++;
+        if (counting && order.equal(current->next->word, word)) // multiset mode : the word is already here, count it
+        {
+            current->next->count++;
+            return;
+        }
+        // make new node with new word and insert it into the list
+        Node *node = newNode(word, current->next, current); //  next node of the new node is the next node of the current node, and previous node of the new node is the current node
+        indexInsert(node);
+        // change pointers of existing nodes to include new node
+        current->next->prev = node; // the previous node of the next node of the current node is set to the new node
+        current->next = node;       // the next node of the current node is set to the new node
+        size++;
+    }
+}
+
+// Remove a word from the list
+template <class T, class Compare, class Allocator>
+bool BasicWordList<T, Compare, Allocator>::remove(const T &word)
+{
+    Node *node = search(word); // search for the word in the list (one probe of the hash table when indexed)
+    if (node == nullptr)
+    {
+        return false;
+    }
+    word_count--;
+    if (node->count > 1) // multiset mode : one occurrence less
+    {
+        node->count--;
+        return true;
+    }
+    unlink(node);
+    return true;
+}
+
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::unlink(Node *node)
+{
+    indexErase(node);
+    if (node->prev != nullptr) // if not at beginning
+    {
+        node->prev->next = node->next; // the next of the previous node is set to the next of the current node
+    }
+    else // if at beginning
+    {
+        head = node->next; // the head is set to the next of the current node
+    }
+    // if not at end
+    if (node->next != nullptr)
+    {
+        node->next->prev = node->prev; // the previous of the next node is set to the previous of the current node
+    }
+    else // if at end
+    {
+        tail = node->prev; // the tail is set to the previous of the current node
+    }
+    deleteNode(node);
+    size--;
+}
+
+// How many times word is in the list : its count while counting, otherwise a walk over every node
+template <class T, class Compare, class Allocator>
+size_t BasicWordList<T, Compare, Allocator>::count(const T &word) const
+{
+    if (counting)
+    {
+        Node *node = search(word);
+        return node != nullptr ? node->count : 0;
+    }
+    size_t found = 0;
+    for (Node *node = head; node != nullptr; node = node->next)
+    {
+        found += order.equal(node->word, word) ? node->count : 0;
+    }
+    return found;
+}
+
+// Fetch the word at the specified index
+template <class T, class Compare, class Allocator>
+T BasicWordList<T, Compare, Allocator>::fetchWord(int index) const // eg. list.fetchWord(2);
+{
+    Node *node = getWord(index); // get the node at the specified index
+    if (node == nullptr)
+    {
+        throw std::runtime_error("Index out of range");
+    }
+    return node->word; // return the word of the node
+}
+
+// Print the list with n words per line
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::print(ostream &os, int n) const // eg. list.print(cout, 5);
+{
+    TRACE_SCOPE("WordList::print");
+    Node *current = head;      // pointer to the head of the list
+    int count = 0;             // counter to keep track of the number of words printed
+    while (current != nullptr) // as long as the current node is not nullptr
+    {
+        for (size_t copy = 0; copy < current->count; ++copy) // a counted word is printed as many times as it occurs
+        {
+            os << current->word << ' '; // print the word of the current node
+            if (++count % n == 0)       // if the number of words printed is a multiple of n (eg . 5, 10, 15, etc.)
+            {
+                os << '\n'; // print a newline
+            }
+        }
+        current = current->next; // move to the next node
+    }
+    if (count % n != 0) // if the number of words printed is not a multiple of n (not equal to 5, 10, 15, etc.)
+                        // write this and not simply "/n" because if the last line is a multiple, they've already printed a newline
+    {
+        os << '\n'; // print a newline
+    }
+}
+
+// Search for a word in the list
+template <class T, class Compare, class Allocator>
+typename BasicWordList<T, Compare, Allocator>::Node *BasicWordList<T, Compare, Allocator>::search(const T &word) const
+{
+    if (indexed)
+    {
+        if (table_capacity == 0)
+        {
+            return nullptr;
+        }
+        uint64_t hash = order.hash(word);
+        size_t mask = table_capacity - 1;
+        for (size_t i = hash & mask; table[i] != nullptr; i = (i + 1) & mask) // probe until an empty slot
+        {
+            if (table[i]->hash == hash && order.equal(table[i]->word, word)) // cached hash first, strcmp only on a match
+            {
+                return table[i];
+            }
+        }
+        return nullptr;
+    }
+    Node *current = head; // pointer to the head of the list
+    while (current != nullptr)
+    {
+        if (order.equal(current->word, word)) // if the word of the current node is equal to the word we are searching for
+        {
+            return current; //  return the current node
+        }
+        current = current->next; // else move to the next node
+    }
+    return nullptr; // if empty list or word not found
+}
+
+// Get the node at the specified index
+template <class T, class Compare, class Allocator>
+typename BasicWordList<T, Compare, Allocator>::Node *BasicWordList<T, Compare, Allocator>::getWord(int n) const
+{
+    if (n >= size)
+    {
+        throw std::runtime_error("Index out of range");
+    }
+    Node *current = head;       // pointer to the head of the list
+    for (int i = 0; i < n; i++) // loop through the list until the specified index
+    {
+        current = current->next;
+    }
+    return current; // return the node at the specified index
+}
+
+// Overloaded insertion operator, the iterator hands out a counted word as many times as it occurs
+template <class T, class Compare, class Allocator>
+ostream &operator<<(ostream &os, const BasicWordList<T, Compare, Allocator> &list)
+{
+    for (typename BasicWordList<T, Compare, Allocator>::const_iterator it = list.begin(); it != list.end(); ++it) // loop through the list
+    {
+        os << *it << ' '; // print the word of the current node
+    }
+    return os;
+}
+
+template <class T, class Compare, class Allocator>
+bool BasicWordList<T, Compare, Allocator>::lookup(const T &word) const
+{
+    return search(word) != nullptr; // if the word is found in the list, return true, else return false
+}
+
+// The index may land on any copy of word, the copies are next to each other in a sorted list so the first is just before it
+template <class T, class Compare, class Allocator>
+typename BasicWordList<T, Compare, Allocator>::const_iterator BasicWordList<T, Compare, Allocator>::find(const T &word) const
+{
+    Node *node = search(word);
+    while (node != nullptr && node->prev != nullptr && order.equal(node->prev->word, word))
+    {
+        node = node->prev;
+    }
+    return const_iterator(node); // nullptr is end()
+}
+
+
+// Merge two sorted lists in one walk by relinking the nodes of other : no word is copied and nothing is allocated
+// list1.merge(list2); // list1 holds both lists in sorted order, list2 is empty, equal words from list1 come first
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::merge(BasicWordList &other)
+{
+    TRACE_SCOPE("WordList::merge");
+    if (this == &other || other.isEmpty())
+    {
+        return;
+    }
+    if (indexed && !other.indexed) // the nodes coming in need their hash for this list's table
+    {
+        for (Node *node = other.head; node != nullptr; node = node->next)
+        {
+            node->hash = order.hash(node->word);
+        }
+    }
+    word_count += other.word_count;
+    size_t folded = 0;        // nodes of other whose word was already placed, counted into the node before them
+    Node *mine = head;        // next node of this list to place
+    Node *theirs = other.head; // next node of the other list to place
+    Node *last = nullptr;     // last node of the merged list so far
+    head = nullptr;
+    while (mine != nullptr || theirs != nullptr)
+    {
+        Node *node;
+        if (theirs == nullptr || (mine != nullptr && !order(theirs->word, mine->word))) // take from this list on ties
+        {
+            node = mine;
+            mine = mine->next;
+        }
+        else
+        {
+            node = theirs;
+            theirs = theirs->next;
+        }
+        if (counting && last != nullptr && order.equal(last->word, node->word)) // multiset mode : one node per word
+        {
+            last->count += node->count;
+            deleteNode(node); // not in this list's table yet, the table is rebuilt below
+            ++folded;
+            continue;
+        }
+        node->prev = last; // append node after last
+        if (last != nullptr)
+        {
+            last->next = node;
+        }
+        else
+        {
+            head = node;
+        }
+        last = node;
+    }
+    last->next = nullptr;
+    tail = last;
+    size += other.size - folded;
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+    other.word_count = 0;
+    other.freeTable();
+    if (indexed)
+    {
+        rehash(table_capacity); // every node of other needs a slot, rebuilding is as cheap as the walk above
+    }
+}
+
+// Turn the hash index on or off : list.enableIndex(); lookups and removals then cost one probe instead of a walk
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::enableIndex(bool enable)
+{
+    TRACE_SCOPE("WordList::enableIndex");
+    if (enable == indexed)
+    {
+        return;
+    }
+    indexed = enable;
+    if (!enable)
+    {
+        freeTable();
+        return;
+    }
+    for (Node *node = head; node != nullptr; node = node->next)
+    {
+        node->hash = order.hash(node->word); // cached so probing and rehashing never hash a word again
+    }
+    rehash(0);
+}
+
+// Counting on folds each run of equal neighbours into one node (all the duplicates of a sorted list),
+// counting off gives every occurrence its own node again
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::enableCounts(bool enable)
+{
+    TRACE_SCOPE("WordList::enableCounts");
+    if (enable == counting)
+    {
+        return;
+    }
+    counting = enable;
+    for (Node *node = head; node != nullptr; node = node->next)
+    {
+        if (enable)
+        {
+            while (node->next != nullptr && order.equal(node->next->word, node->word))
+            {
+                node->count += node->next->count;
+                node->next->count = 1;
+                unlink(node->next);
+            }
+        }
+        else
+        {
+            for (; node->count > 1; node->count--) // the copies go right after node, node then steps over them
+            {
+                Node *copy = newNode(node->word, node->next, node);
+                indexInsert(copy);
+                if (node->next != nullptr)
+                {
+                    node->next->prev = copy;
+                }
+                else
+                {
+                    tail = copy;
+                }
+                node->next = copy;
+                size++;
+            }
+        }
+    }
+}
+
+template <class T, class Compare, class Allocator>
+bool BasicWordList<T, Compare, Allocator>::hasCounts() const
+{
+    return counting;
+}
+
+template <class T, class Compare, class Allocator>
+size_t BasicWordList<T, Compare, Allocator>::occurrences() const
+{
+    return word_count;
+}
+
+template <class T, class Compare, class Allocator>
+bool BasicWordList<T, Compare, Allocator>::hasIndex() const
+{
+    return indexed;
+}
+
+template <class T, class Compare, class Allocator>
+size_t BasicWordList<T, Compare, Allocator>::bytes() const
+{
+    size_t total = table_capacity * sizeof(Node *);
+    for (Node *node = head; node != nullptr; node = node->next)
+    {
+        total += sizeof(Node) + heapBytes(node->word);
+    }
+    return total;
+}
+
+// Every node is one allocation of links and a Word, plus the characters of the word and the hash table
+template <class T, class Compare, class Allocator>
+MemoryUsage BasicWordList<T, Compare, Allocator>::memoryUsage() const
+{
+    MemoryUsage usage;
+    for (Node *node = head; node != nullptr; node = node->next)
+    {
+        usage.addAllocation(sizeof(Node), 0, sizeof(Node));
+        usage += heapUsage(node->word);
+    }
+    if (table != nullptr)
+    {
+        usage.addAllocation(table_capacity * sizeof(Node *), 0, size * sizeof(Node *)); // empty slots are unused
+    }
+    return usage;
+}
+
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::shrinkToFit()
+{
+    TRACE_SCOPE("WordList::shrinkToFit");
+    if (indexed)
+    {
+        rehash(0); // the table only ever grows as words are added
+    }
+}
+
+// Rebuild the table with at least new_capacity slots, growing it so it stays at most 70% full
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::rehash(size_t new_capacity)
+{
+    TRACE_SCOPE("WordList::rehash");
+    size_t capacity = 16;
+    while (capacity < new_capacity || size * 10 >= capacity * 7)
+    {
+        capacity *= 2;
+    }
+    freeTable();
+    table = TableTraits::allocate(table_allocator, capacity);
+    fill(table, table + capacity, static_cast<Node *>(nullptr)); // every slot starts empty
+    table_capacity = capacity;
+    size_t mask = capacity - 1;
+    for (Node *node = head; node != nullptr; node = node->next)
+    {
+        size_t i = node->hash & mask;
+        while (table[i] != nullptr)
+        {
+            i = (i + 1) & mask;
+        }
+        table[i] = node;
+    }
+}
+
+// Give a new node a slot, called before the node is linked into the list and counted in size
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::indexInsert(Node *node)
+{
+    if (!indexed)
+    {
+        return;
+    }
+    node->hash = order.hash(node->word);
+    if ((size + 1) * 10 > table_capacity * 7) // would be more than 70% full
+    {
+        rehash(table_capacity * 2); // places the nodes already in the list
+    }
+    size_t mask = table_capacity - 1;
+    size_t i = node->hash & mask;
+    while (table[i] != nullptr)
+    {
+        i = (i + 1) & mask;
+    }
+    table[i] = node;
+}
+
+// Free the slot of node, then shift back the entries after it that would otherwise become unreachable
+// (linear probing without tombstones, so the table never fills up with deleted entries)
+template <class T, class Compare, class Allocator>
+void BasicWordList<T, Compare, Allocator>::indexErase(Node *node)
+{
+    if (!indexed || table_capacity == 0)
+    {
+        return;
+    }
+    size_t mask = table_capacity - 1;
+    size_t hole = node->hash & mask;
+    while (table[hole] != node)
+    {
+        hole = (hole + 1) & mask;
+    }
+    table[hole] = nullptr;
+    for (size_t i = (hole + 1) & mask; table[i] != nullptr; i = (i + 1) & mask)
+    {
+        size_t home = table[i]->hash & mask;
+        bool reachable = hole < i ? (home > hole && home <= i) : (home > hole || home <= i); // home cyclically in (hole, i]
+        if (!reachable)
+        {
+            table[hole] = table[i];
+            table[i] = nullptr;
+            hole = i;
+        }
+    }
+}
+
+// Iterators : begin() points at the head node, end() is one past the tail (nullptr)
+template <class T, class Compare, class Allocator>
+typename BasicWordList<T, Compare, Allocator>::const_iterator BasicWordList<T, Compare, Allocator>::begin() const
+{
+    return const_iterator(head);
+}
+
+template <class T, class Compare, class Allocator>
+typename BasicWordList<T, Compare, Allocator>::const_iterator BasicWordList<T, Compare, Allocator>::end() const
+{
+    return const_iterator(nullptr);
+}
@@ -0,0 +1,386 @@
+#include "WordLog.h"
+#include <stdexcept> // runtime_error
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+namespace
+{
+    const char LOG_MAGIC[8] = {'A', '1', 'L', 'O', 'G', '0', '0', '1'};
+    const char SNAPSHOT_MAGIC[8] = {'A', '1', 'S', 'N', 'A', 'P', '0', '1'};
+    const size_t HEADER_SIZE = 16; // magic and generation
+
+    void throwErrno(const string &what)
+    {
+        throw runtime_error(what + ": " + strerror(errno));
+    }
+
+    void putU32(string &out, uint32_t value)
+    {
+        out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    void putU64(string &out, uint64_t value)
+    {
+        out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    uint32_t getU32(const char *p)
+    {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    uint64_t getU64(const char *p)
+    {
+        uint64_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    void writeAll(int fd, const char *data, size_t length, const string &path)
+    {
+        while (length > 0)
+        {
+            ssize_t n = write(fd, data, length);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throwErrno(path);
+            }
+            data += n;
+            length -= n;
+        }
+    }
+
+    // Whole file into out; false if it does not exist
+    bool readFile(const string &path, string &out)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            if (errno == ENOENT)
+            {
+                return false;
+            }
+            throwErrno(path);
+        }
+        out.clear();
+        char buffer[1 << 16];
+        ssize_t n;
+        while ((n = read(fd, buffer, sizeof(buffer))) != 0)
+        {
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                close(fd);
+                throwErrno(path);
+            }
+            out.append(buffer, n);
+        }
+        close(fd);
+        return true;
+    }
+
+    // Write data to path.tmp, flush it to disk, then rename it over path so path is always either old or new
+    void replaceFile(const string &path, const string &data)
+    {
+        string temporary = path + ".tmp";
+        int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1)
+        {
+            throwErrno(temporary);
+        }
+        writeAll(fd, data.data(), data.size(), temporary);
+        if (fsync(fd) != 0)
+        {
+            close(fd);
+            throwErrno(temporary);
+        }
+        close(fd);
+        if (rename(temporary.c_str(), path.c_str()) != 0)
+        {
+            throwErrno(path);
+        }
+        size_t slash = path.rfind('/'); // the rename itself is only durable once the directory is flushed
+        string directory = slash == string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+        int dir_fd = ::open(directory.c_str(), O_RDONLY);
+        if (dir_fd != -1)
+        {
+            fsync(dir_fd);
+            close(dir_fd);
+        }
+    }
+
+    uint32_t checksum(const char *data, size_t length)
+    {
+        return static_cast<uint32_t>(Word::hash(data, length));
+    }
+}
+
+WordLog::WordLog() : fd(-1), generation(0), records(0) {}
+
+WordLog::~WordLog()
+{
+    try
+    {
+        commit();
+    }
+    catch (const exception &e) // a destructor must not throw
+    {
+        cerr << e.what() << '\n';
+    }
+    if (fd != -1)
+    {
+        close(fd);
+    }
+}
+
+// log.open("vocabulary", vec); vec is filled from vocabulary.snap and vocabulary.log (both may be missing),
+// every later append goes to vocabulary.log
+void WordLog::open(const char *base_name, WordCatVec &vocabulary)
+{
+    base = base_name;
+    uint64_t snapshot_generation = loadSnapshot(vocabulary);
+    replay(vocabulary, snapshot_generation);
+}
+
+uint64_t WordLog::loadSnapshot(WordCatVec &vocabulary) const
+{
+    string path = base + ".snap";
+    string data;
+    if (!readFile(path, data))
+    {
+        return 0;
+    }
+    if (data.size() < HEADER_SIZE || memcmp(data.data(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+    {
+        throw runtime_error(path + ": not a snapshot file");
+    }
+    const char *p = data.data() + HEADER_SIZE;
+    const char *end = data.data() + data.size();
+    while (p < end)
+    {
+        if (end - p < 4 || end - p - 4 < getU32(p))
+        {
+            throw runtime_error(path + ": truncated");
+        }
+        WordCat category(Word(p + 4, getU32(p)));
+        p += 4 + getU32(p);
+        if (end - p < 4)
+        {
+            throw runtime_error(path + ": truncated");
+        }
+        uint32_t count = getU32(p);
+        p += 4;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (end - p < 4 || end - p - 4 < getU32(p))
+            {
+                throw runtime_error(path + ": truncated");
+            }
+            category.insertWord(Word(p + 4, getU32(p))); // written in order, so each insert goes at the back
+            p += 4 + getU32(p);
+        }
+        vocabulary.addCategory(category);
+    }
+    return getU64(data.data() + 8);
+}
+
+// Apply every complete record of a log that follows the snapshot, cut off a torn tail and keep appending after it
+void WordLog::replay(WordCatVec &vocabulary, uint64_t snapshot_generation)
+{
+    string path = base + ".log";
+    string data;
+    generation = snapshot_generation;
+    records = 0;
+    if (!readFile(path, data) || data.size() < HEADER_SIZE || memcmp(data.data(), LOG_MAGIC, sizeof(LOG_MAGIC)) != 0 ||
+        getU64(data.data() + 8) != snapshot_generation) // missing, torn header, or already in the snapshot
+    {
+        startLog();
+        return;
+    }
+    size_t offset = HEADER_SIZE;
+    while (data.size() - offset >= 13) // op and both lengths, checksum
+    {
+        const char *record = data.data() + offset;
+        size_t first_length = getU32(record + 1);
+        size_t second_length = getU32(record + 5);
+        size_t body = 9 + first_length + second_length;
+        if (first_length > data.size() || second_length > data.size() || data.size() - offset < body + 4 ||
+            getU32(record + body) != checksum(record, body))
+        {
+            break;
+        }
+        apply(vocabulary, static_cast<Op>(record[0]), string(record + 9, first_length), string(record + 9 + first_length, second_length));
+        ++records;
+        offset += body + 4;
+    }
+    fd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+    if (fd == -1)
+    {
+        throwErrno(path);
+    }
+    if (offset < data.size() && ftruncate(fd, offset) != 0) // the partial record of a crash in the middle of a write
+    {
+        throwErrno(path);
+    }
+}
+
+void WordLog::apply(WordCatVec &vocabulary, Op op, const string &first, const string &second) const
+{
+    if (op == ADD_CATEGORY)
+    {
+        vocabulary.addCategory(WordCat(Word(first.c_str())));
+        return;
+    }
+    WordCat *category = vocabulary.getCategory(first.c_str());
+    if (category == nullptr)
+    {
+        return;
+    }
+    switch (op)
+    {
+    case REMOVE_CATEGORY:
+        vocabulary.removeCategory(first.c_str());
+        break;
+    case CLEAR_CATEGORY:
+        category->clearWords();
+        break;
+    case RENAME_CATEGORY:
+        category->modifyCategoryName(Word(second.c_str()));
+        break;
+    case INSERT_WORD:
+        category->insertWord(Word(second.data(), second.size()));
+        break;
+    case REMOVE_WORD:
+        category->removeWord(Word(second.data(), second.size()));
+        break;
+    case MERGE_CATEGORIES:
+    {
+        WordCat *other = vocabulary.getCategory(second.c_str());
+        if (other != nullptr)
+        {
+            category->merge(*other);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+// Replace the log by one that only has the header for the current generation
+void WordLog::startLog()
+{
+    string path = base + ".log";
+    string header(LOG_MAGIC, sizeof(LOG_MAGIC));
+    putU64(header, generation);
+    replaceFile(path, header);
+    if (fd != -1)
+    {
+        close(fd);
+    }
+    fd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+    if (fd == -1)
+    {
+        throwErrno(path);
+    }
+    records = 0;
+}
+
+void WordLog::append(Op op, const char *first, size_t first_length, const char *second, size_t second_length)
+{
+    size_t start = pending.size();
+    pending += static_cast<char>(op);
+    putU32(pending, static_cast<uint32_t>(first_length));
+    putU32(pending, static_cast<uint32_t>(second_length));
+    pending.append(first, first_length);
+    pending.append(second, second_length);
+    putU32(pending, checksum(pending.data() + start, pending.size() - start));
+    ++records;
+    if (pending.size() >= GROUP_BYTES)
+    {
+        commit();
+    }
+}
+
+void WordLog::append(Op op, const Word &first)
+{
+    append(op, first.c_str(), first.length());
+}
+
+void WordLog::append(Op op, const Word &first, const Word &second)
+{
+    append(op, first.c_str(), first.length(), second.c_str(), second.length());
+}
+
+// One write and one fdatasync for every record appended since the last commit
+void WordLog::commit()
+{
+    if (pending.empty() || fd == -1)
+    {
+        return;
+    }
+    off_t end = lseek(fd, 0, SEEK_END); // where the log ended before this write
+    try
+    {
+        writeAll(fd, pending.data(), pending.size(), base + ".log");
+        if (fdatasync(fd) != 0)
+        {
+            throwErrno(base + ".log");
+        }
+    }
+    catch (...)
+    {
+        if (end != -1) // no partial record is left for the next commit to write after (replay would stop at it)
+        {
+            int truncated = ftruncate(fd, end);
+            (void)truncated; // the write error is the one reported
+        }
+        throw; // the records stay pending, a later commit tries them again
+    }
+    pending.clear();
+}
+
+bool WordLog::wantsCheckpoint() const
+{
+    return records >= CHECKPOINT_RECORDS;
+}
+
+// The snapshot holds everything, so records still pending are dropped instead of written
+void WordLog::checkpoint(const WordCatVec &vocabulary)
+{
+    if (fd == -1)
+    {
+        return;
+    }
+    string data(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    putU64(data, generation + 1);
+    for (size_t i = 0; i < vocabulary.length(); ++i)
+    {
+        const WordCat &category = vocabulary.at(i);
+        putU32(data, static_cast<uint32_t>(strlen(category.c_str())));
+        data += category.c_str();
+        putU32(data, static_cast<uint32_t>(category.length())); // every word the cursor below writes, duplicates included
+        for (WordCat::Cursor cursor(category); cursor.valid(); cursor.next())
+        {
+            putU32(data, static_cast<uint32_t>(cursor.length()));
+            data.append(cursor.data(), cursor.length());
+        }
+    }
+    replaceFile(base + ".snap", data);
+    ++generation; // a crash from here on leaves a log of the old generation, which the next open() drops
+    pending.clear();
+    startLog();
+}
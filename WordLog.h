@@ -0,0 +1,62 @@
+#ifndef WORDLOG_H
+#define WORDLOG_H
+
+#include "WordCatVec.h"
+#include <stdint.h>
+#include <string>
+
+// Makes edits durable without rewriting the vocabulary : every edit is appended to <base>.log, and from time to time
+// the whole vocabulary is written to a compact snapshot, <base>.snap, after which the log starts again empty.
+// On startup the snapshot is loaded and the log written since is replayed, so recovery only pays for the tail.
+//
+// Records are kept in memory until commit(), which writes them all with one write and one fdatasync (group commit) :
+//   record   : op (1 byte), first length (4), second length (4), first, second, checksum (4)
+//   log      : "A1LOG001", generation (8), records...
+//   snapshot : "A1SNAP01", generation (8), then per category : name length (4), name, word count (4), (length (4), word)...
+// Integers are in host byte order. A torn or corrupt record ends the replay and is cut off the log.
+// The generation ties a log to the snapshot it follows : a log left from before the last checkpoint is already
+// in the snapshot and is dropped.
+class WordLog
+{
+public:
+    enum Op
+    {
+        ADD_CATEGORY = 1, // first : category
+        REMOVE_CATEGORY,  // first : category
+        CLEAR_CATEGORY,   // first : category
+        RENAME_CATEGORY,  // first : old name, second : new name
+        INSERT_WORD,      // first : category, second : word
+        REMOVE_WORD,      // first : category, second : word
+        MERGE_CATEGORIES  // first : category merged into, second : category emptied
+    };
+
+    static const size_t GROUP_BYTES = 1 << 16;          // pending records this large are written without waiting for commit()
+    static const size_t CHECKPOINT_RECORDS = 1 << 16; // wantsCheckpoint() once the log holds this many records
+
+    WordLog();
+    WordLog(const WordLog &) = delete;
+    WordLog &operator=(const WordLog &) = delete;
+    ~WordLog(); // commits what is pending
+
+    void open(const char *base, WordCatVec &vocabulary); // loads the snapshot and replays the log into vocabulary
+    void append(Op op, const char *first, size_t first_length, const char *second = "", size_t second_length = 0);
+    void append(Op op, const Word &first);
+    void append(Op op, const Word &first, const Word &second);
+    void commit();
+    bool wantsCheckpoint() const;
+    void checkpoint(const WordCatVec &vocabulary); // snapshot of vocabulary, then an empty log
+
+private:
+    std::string base;
+    int fd; // the log, -1 until open()
+    uint64_t generation;
+    std::string pending; // records not yet written
+    size_t records;      // records in the log since the last checkpoint
+
+    uint64_t loadSnapshot(WordCatVec &vocabulary) const; // generation of the snapshot, 0 if there is none
+    void replay(WordCatVec &vocabulary, uint64_t snapshot_generation);
+    void startLog(); // a new log holding only the header for generation
+    void apply(WordCatVec &vocabulary, Op op, const std::string &first, const std::string &second) const;
+};
+
+#endif // WORDLOG_H
@@ -0,0 +1,147 @@
+#include "WordReader.h"
+#include "Trace.h"
+#include <stdexcept> // runtime_error
+#include <cerrno>
+#include <cctype>  // isspace
+#include <cstring> // memchr, memmove
+#include <unistd.h> // read
+using namespace std;
+
+// Constructor : WordReader reader(STDIN_FILENO);
+WordReader::WordReader(int fd, size_t buffer_size)
+    : fd(fd), buffer(new char[buffer_size]), capacity(buffer_size), start(0), end(0), eof(false), total(0) {}
+
+WordReader::~WordReader()
+{
+    delete[] buffer;
+}
+
+// Move the unread bytes to the front of the buffer and read after them.
+// When the unread bytes already fill the buffer they belong to one huge token : they go to the spill string.
+bool WordReader::fill()
+{
+    if (eof)
+    {
+        return false;
+    }
+    if (start > 0)
+    {
+        memmove(buffer, buffer + start, end - start);
+        end -= start;
+        start = 0;
+    }
+    else if (end == capacity)
+    {
+        spill.append(buffer, end);
+        start = end = 0;
+    }
+    while (true)
+    {
+        ssize_t n;
+        {
+            TRACE_SCOPE("read"); // load phase
+            n = read(fd, buffer + end, capacity - end);
+        }
+        if (n > 0)
+        {
+            end += n;
+            total += n;
+            return true;
+        }
+        if (n == 0)
+        {
+            eof = true;
+            return false;
+        }
+        if (errno != EINTR)
+        {
+            throw runtime_error(string("Failed to read input: ") + strerror(errno));
+        }
+    }
+}
+
+// Whatever sits in the buffer (spilled bytes included) has been handed out or is still to come
+uint64_t WordReader::offset() const
+{
+    return total - (end - start);
+}
+
+bool WordReader::nextToken(const char *&data, size_t &length)
+{
+    return next(false, data, length);
+}
+
+bool WordReader::nextLine(const char *&data, size_t &length)
+{
+    return next(true, data, length);
+}
+
+bool WordReader::next(bool lines, const char *&data, size_t &length)
+{
+    spill.clear();
+    if (!lines) // skip the whitespace before the token
+    {
+        while (true)
+        {
+            while (start < end && isspace(static_cast<unsigned char>(buffer[start])))
+            {
+                ++start;
+            }
+            if (start < end || !fill())
+            {
+                break;
+            }
+        }
+        if (start == end)
+        {
+            return false;
+        }
+    }
+    else if (start == end && !fill())
+    {
+        return false;
+    }
+
+    size_t scanned = start; // bytes before this position are known not to end the token
+    while (true)
+    {
+        size_t stop = scanned;
+        if (lines)
+        {
+            const char *newline = static_cast<const char *>(memchr(buffer + scanned, '\n', end - scanned));
+            stop = newline != nullptr ? newline - buffer : end;
+        }
+        else
+        {
+            while (stop < end && !isspace(static_cast<unsigned char>(buffer[stop])))
+            {
+                ++stop;
+            }
+        }
+        if (stop < end || eof) // found the end of the token (or of the input)
+        {
+            size_t token_start = start;
+            start = stop < end ? stop + 1 : stop; // the separator is consumed too
+            if (spill.empty())
+            {
+                data = buffer + token_start;
+                length = stop - token_start;
+            }
+            else
+            {
+                spill.append(buffer + token_start, stop - token_start);
+                data = spill.data();
+                length = spill.size();
+            }
+            if (lines && length > 0 && data[length - 1] == '\r') // CRLF files
+            {
+                --length;
+            }
+            return true;
+        }
+        size_t pending = end - start; // the whole unread part is this token so far, already scanned
+        size_t spilled = spill.size();
+        fill(); // at the end of the input the next pass returns what is left
+        scanned = spill.size() > spilled ? start : start + pending; // fill() moved the partial token to the front or into spill
+    }
+}
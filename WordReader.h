@@ -0,0 +1,40 @@
+#ifndef WORDREADER_H
+#define WORDREADER_H
+
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+
+// Splits any file descriptor (a file, stdin, a pipe) into whitespace separated tokens or into lines,
+// reading through one fixed-size buffer : memory stays the same whatever the size of the input.
+// Each token is handed out as a view into the buffer, valid until the next call, so nothing is allocated
+// per token; only a token longer than the whole buffer is gathered in a spill string that is reused.
+class WordReader
+{
+public:
+    static const size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+    explicit WordReader(int fd, size_t buffer_size = DEFAULT_BUFFER_SIZE); // the fd stays owned by the caller
+    WordReader(const WordReader &) = delete;
+    WordReader &operator=(const WordReader &) = delete;
+    ~WordReader();
+
+    bool nextToken(const char *&data, size_t &length); // false at end of input
+    bool nextLine(const char *&data, size_t &length);  // without the '\n' (and '\r'), empty lines included
+    uint64_t offset() const; // bytes of input used up so far, separators included : where the next token or line starts
+
+private:
+    int fd;
+    char *buffer;
+    size_t capacity;
+    size_t start;      // first byte not handed out yet
+    size_t end;        // one past the last byte read
+    bool eof;
+    uint64_t total;    // bytes read from fd
+    std::string spill; // pieces of a token that did not fit in the buffer
+
+    bool fill(); // makes room and reads more, false once the input is exhausted
+    bool next(bool lines, const char *&data, size_t &length);
+};
+
+#endif // WORDREADER_H
@@ -0,0 +1,502 @@
+#include "WordServer.h"
+#include "MergedWordCursor.h"
+#include <sstream>   // ostringstream for prefix replies
+#include <stdexcept> // runtime_error
+#include <cerrno>
+#include <csignal>
+#include <cstdlib> // strtoul
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+using namespace std;
+
+namespace
+{
+    volatile sig_atomic_t stop_requested = 0; // set by the signal handler, checked by the event loop
+
+    void requestStop(int)
+    {
+        stop_requested = 1;
+    }
+
+    void throwErrno(const char *what)
+    {
+        throw runtime_error(string(what) + ": " + strerror(errno));
+    }
+}
+
+// Constructor : WordServer server(vec); the vocabulary is not copied, the server answers from vec directly
+WordServer::WordServer(WordCatVec &vocabulary) : vocabulary(vocabulary), listen_fd(-1), epoll_fd(-1) {}
+
+// Destructor : closes every client, the listening socket and the epoll instance
+WordServer::~WordServer()
+{
+    for (unordered_map<int, Client>::iterator it = clients.begin(); it != clients.end(); ++it)
+    {
+        close(it->first);
+    }
+    if (listen_fd != -1)
+    {
+        close(listen_fd);
+    }
+    if (epoll_fd != -1)
+    {
+        close(epoll_fd);
+    }
+}
+
+// Bind the socket and run the event loop until SIGINT or SIGTERM
+void WordServer::serve(const char *socket_path)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(address.sun_path))
+    {
+        throw runtime_error("Socket path too long.");
+    }
+    strcpy(address.sun_path, socket_path);
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd == -1)
+    {
+        throwErrno("socket");
+    }
+    unlink(socket_path); // remove a stale socket left by a previous run
+    if (bind(listen_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == -1)
+    {
+        throwErrno("bind");
+    }
+    if (listen(listen_fd, SOMAXCONN) == -1)
+    {
+        throwErrno("listen");
+    }
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd == -1)
+    {
+        throwErrno("epoll_create1");
+    }
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = listen_fd;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &event) == -1)
+    {
+        throwErrno("epoll_ctl");
+    }
+
+    // no SA_RESTART so that epoll_wait returns EINTR and the loop can notice the stop request
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = requestStop;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    stop_requested = 0;
+
+    const int MAX_EVENTS = 64;
+    epoll_event events[MAX_EVENTS];
+    while (!stop_requested)
+    {
+        int ready = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
+        if (ready == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throwErrno("epoll_wait");
+        }
+        for (int i = 0; i < ready; ++i)
+        {
+            int fd = events[i].data.fd;
+            if (fd == listen_fd)
+            {
+                acceptClients();
+                continue;
+            }
+            if (events[i].events & EPOLLIN)
+            {
+                readClient(fd); // may close the client, answers whatever arrived before a hang-up
+            }
+            else if (events[i].events & (EPOLLERR | EPOLLHUP))
+            {
+                closeClient(fd);
+                continue;
+            }
+            if ((events[i].events & EPOLLOUT) && clients.count(fd))
+            {
+                writeClient(fd);
+            }
+        }
+    }
+    unlink(socket_path);
+}
+
+// Accept every pending connection (the listening socket is non-blocking)
+void WordServer::acceptClients()
+{
+    while (true)
+    {
+        int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd == -1)
+        {
+            return; // EAGAIN : no more pending connections ; other errors : drop this attempt
+        }
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1)
+        {
+            close(fd);
+            continue;
+        }
+        clients[fd]; // creates an empty Client
+    }
+}
+
+// Drain the socket, answering the complete lines as they arrive, make the batch durable, then try to send the replies
+void WordServer::readClient(int fd)
+{
+    Client &client = clients[fd];
+    size_t replied = client.out.size(); // where the replies of this batch start
+    size_t requests = 0;
+    char buffer[65536];
+    bool closed = false;
+    while (true)
+    {
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n > 0)
+        {
+            client.in.append(buffer, n);
+            requests += executeLines(client);
+            if (client.in.size() > MAX_LINE) // checked as the bytes come in, a client cannot make in grow without bound
+            {
+                closeClient(fd);
+                return;
+            }
+            continue;
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+        {
+            closed = true; // peer hung up or the socket failed, still answer what was received
+        }
+        else if (errno == EINTR)
+        {
+            continue;
+        }
+        break;
+    }
+
+    try
+    {
+        vocabulary.commitLog(); // the edits of the whole batch are durable before any reply is sent
+    }
+    catch (const exception &e) // they stay in memory, but no request of the batch is acknowledged
+    {
+        client.out.erase(replied);
+        for (size_t i = 0; i < requests; ++i)
+        {
+            client.out += "ERR ";
+            client.out += e.what();
+            client.out += '\n';
+        }
+    }
+    client.closing = closed;
+    writeClient(fd); // closes the client once everything is sent if it is closing
+}
+
+// Answer every complete line of client.in, the trailing partial line stays for the next read
+size_t WordServer::executeLines(Client &client)
+{
+    size_t start = 0;
+    size_t end;
+    size_t requests = 0;
+    while ((end = client.in.find('\n', start)) != string::npos) // one request per line
+    {
+        size_t length = end - start;
+        if (length > 0 && client.in[end - 1] == '\r') // tolerate CRLF clients
+        {
+            --length;
+        }
+        execute(client.in.data() + start, length, client.out);
+        start = end + 1;
+        ++requests;
+    }
+    client.in.erase(0, start);
+    return requests;
+}
+
+// Send as much of the pending replies as the socket accepts, and ask for EPOLLOUT only while some remain
+void WordServer::writeClient(int fd)
+{
+    Client &client = clients[fd];
+    size_t sent = 0;
+    while (sent < client.out.size())
+    {
+        ssize_t n = send(fd, client.out.data() + sent, client.out.size() - sent, MSG_NOSIGNAL);
+        if (n > 0)
+        {
+            sent += n;
+            continue;
+        }
+        if (n == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+        closeClient(fd);
+        return;
+    }
+    client.out.erase(0, sent);
+    if (client.closing && client.out.empty())
+    {
+        closeClient(fd);
+        return;
+    }
+
+    epoll_event event;
+    if (client.closing) // the peer has shut down its side, reading again would only report that
+    {
+        event.events = EPOLLOUT;
+    }
+    else
+    {
+        event.events = client.out.empty() ? EPOLLIN : (EPOLLIN | EPOLLOUT);
+    }
+    event.data.fd = fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+}
+
+void WordServer::closeClient(int fd)
+{
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    clients.erase(fd);
+}
+
+// One reply line whatever happens : a request that throws is answered ERR with the reason, and what it had
+// appended to reply is taken back
+void WordServer::execute(const char *line, size_t length, string &reply)
+{
+    size_t mark = reply.size();
+    try
+    {
+        dispatch(line, length, reply);
+    }
+    catch (const exception &e)
+    {
+        reply.erase(mark);
+        string reason = e.what();
+        for (size_t i = 0; i < reason.size(); ++i)
+        {
+            if (reason[i] == '\n' || reason[i] == '\t')
+            {
+                reason[i] = ' ';
+            }
+        }
+        reply += "ERR " + reason + '\n';
+    }
+}
+
+// Parse one request line and append its reply line to reply
+void WordServer::dispatch(const char *line, size_t length, string &reply)
+{
+    if (length == 0 || (length > 1 && line[1] != ' '))
+    {
+        reply += "ERR bad request\n";
+        return;
+    }
+    string argument = length > 1 ? string(line + 2, length - 2) : string(); // everything after "<verb> ", a bare "T" has none
+
+    switch (line[0])
+    {
+    case 'S':
+    {
+        const vector<string> &names = vocabulary.categoriesContaining(argument.c_str());
+        reply += "OK";
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            reply += '\t';
+            reply += names[i];
+        }
+        reply += '\n';
+        break;
+    }
+    case 'P':
+    {
+        const vector<string> &words = vocabulary.wordsWithPrefix(argument.c_str());
+        reply += "OK";
+        for (size_t i = 0; i < words.size(); ++i)
+        {
+            reply += '\t';
+            reply += words[i];
+        }
+        reply += '\n';
+        break;
+    }
+    case 'A':
+    case 'R':
+    {
+        size_t tab = argument.find('\t');
+        if (tab == string::npos)
+        {
+            reply += "ERR bad request\n";
+            break;
+        }
+        argument[tab] = '\0'; // split into "<category>\0<word>"
+        const char *category = argument.c_str();
+        Word word(argument.c_str() + tab + 1);
+        if (line[0] == 'A' && argument.find('\t', tab + 1) != string::npos)
+        {
+            vector<Word> batch;
+            size_t start = tab + 1;
+            for (size_t next; (next = argument.find('\t', start)) != string::npos; start = next + 1)
+            {
+                batch.push_back(Word(argument.data() + start, next - start));
+            }
+            batch.push_back(Word(argument.data() + start, argument.size() - start));
+            reply += vocabulary.insertWords(category, move(batch)) ? "OK\n" : "ERR no such category\n";
+        }
+        else if (line[0] == 'A')
+        {
+            reply += vocabulary.insertWord(category, word) ? "OK\n" : "ERR no such category\n";
+        }
+        else
+        {
+            reply += vocabulary.removeWord(category, word) ? "OK\n" : "ERR not found\n";
+        }
+        break;
+    }
+    case 'U':
+    case 'I':
+    case 'D':
+    case 'M':
+    {
+        size_t tab = argument.find('\t');
+        if (tab == string::npos)
+        {
+            reply += "ERR bad request\n";
+            break;
+        }
+        argument[tab] = '\0';
+        const char *first = argument.c_str();
+        const char *second = argument.c_str() + tab + 1;
+        if (line[0] == 'M')
+        {
+            reply += vocabulary.combineCategories(first, second, WordCatVec::MERGE) ? "OK\n" : "ERR no such category\n";
+            break;
+        }
+        const WordCat *a = vocabulary.getCategory(first);
+        const WordCat *b = vocabulary.getCategory(second);
+        if (a == nullptr || b == nullptr)
+        {
+            reply += "ERR no such category\n";
+            break;
+        }
+        WordCat result = line[0] == 'U' ? a->unionWith(*b) : (line[0] == 'I' ? a->intersect(*b) : a->difference(*b));
+        ostringstream words;
+        result.printWordsWithPrefix("", words, '\t');
+        string list = words.str();
+        reply += "OK";
+        if (!list.empty())
+        {
+            reply += '\t';
+            reply.append(list, 0, list.size() - 1);
+        }
+        reply += '\n';
+        break;
+    }
+    case 'T':
+    {
+        ostringstream stats;
+        if (argument.empty())
+        {
+            vocabulary.stats().print(stats, '\t');
+        }
+        else
+        {
+            const WordCat *category = vocabulary.getCategory(argument.c_str());
+            if (category == nullptr)
+            {
+                reply += "ERR no such category\n";
+                break;
+            }
+            category->stats().print(stats, '\t');
+        }
+        reply += "OK\t";
+        reply += stats.str();
+        reply += '\n';
+        break;
+    }
+    case 'N':
+    {
+        size_t tab = argument.find('\t');
+        string count_field = argument.substr(0, tab);
+        char *end;
+        unsigned long count = strtoul(count_field.c_str(), &end, 10);
+        if (count_field.empty() || *end != '\0')
+        {
+            reply += "ERR bad request\n";
+            break;
+        }
+        string prefix = tab == string::npos ? string() : argument.substr(tab + 1);
+        reply += "OK";
+        for (MergedWordCursor cursor(vocabulary, prefix.c_str()); cursor.valid() && count > 0; cursor.next(), --count)
+        {
+            reply += '\t';
+            reply.append(cursor.data(), cursor.length());
+            reply += '\t';
+            reply += cursor.category().c_str();
+        }
+        reply += '\n';
+        break;
+    }
+    case 'G':
+    {
+        vector<string> fields; // category, count, after, seen
+        size_t start = 0;
+        for (size_t tab; (tab = argument.find('\t', start)) != string::npos; start = tab + 1)
+        {
+            fields.push_back(argument.substr(start, tab - start));
+        }
+        fields.push_back(argument.substr(start));
+        char *end;
+        unsigned long count = fields.size() >= 2 ? strtoul(fields[1].c_str(), &end, 10) : 0;
+        if (fields.size() < 2 || fields.size() > 4 || fields[1].empty() || *end != '\0')
+        {
+            reply += "ERR bad request\n";
+            break;
+        }
+        const WordCat *category = vocabulary.getCategory(fields[0].c_str());
+        if (category == nullptr)
+        {
+            reply += "ERR no such category\n";
+            break;
+        }
+        size_t seen = fields.size() == 4 ? strtoul(fields[3].c_str(), nullptr, 10) : SIZE_MAX;
+        WordCat::Page page = fields.size() >= 3 ? WordCat::Page(*category, fields[2].data(), fields[2].size(), seen)
+                                                : WordCat::Page(*category);
+        ostringstream words;
+        category->printPage(page, count, words, '\t');
+        string list = words.str();
+        reply += "OK";
+        if (!list.empty())
+        {
+            reply += '\t';
+            reply.append(list, 0, list.size() - 1);
+        }
+        reply += '\n';
+        break;
+    }
+    default:
+        reply += "ERR bad request\n";
+        break;
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef WORDSERVER_H
+#define WORDSERVER_H
+
+#include "WordCatVec.h"
+#include <string>
+#include <unordered_map>
+
+// Daemon that keeps one loaded WordCatVec in memory and answers requests from local clients over a Unix domain socket.
+//
+// Protocol : one request per line, one reply line per request, fields separated by tabs.
+// The verb is followed by a space, which may be left out when there is no argument ("T" is "T ").
+//   S <word>                  -> OK\t<category>\t<category>...   (categories containing the word)
+//   P <prefix>                -> OK\t<word>\t<word>...           (words starting with prefix, all categories)
+//   A <category>\t<word>[\t<word>...]
+//                             -> OK | ERR no such category   (several words are sorted and merged in at once)
+//   R <category>\t<word>      -> OK | ERR not found
+//   U <first>\t<second>       -> OK\t<word>...   (union, the categories are not changed)
+//   I <first>\t<second>       -> OK\t<word>...   (intersection)
+//   D <first>\t<second>       -> OK\t<word>...   (difference, first - second)
+//   M <first>\t<second>       -> OK | ERR no such category   (second is merged into first and removed)
+//   T [<category>]            -> OK\tWords: n\tBytes: n\tLengths: ...\tLetters: ...   (one category, or all of them)
+//   N <count>[\t<prefix>]      -> OK\t<word>\t<category>\t<word>\t<category>...   (first count words starting with prefix,
+//                                                 all categories merged in sorted order)
+//   G <category>\t<count>[\t<after>[\t<seen>]]
+//                             -> OK\t<word>...   (next page : at most count words after the first seen copies of after,
+//                                                 after every copy if seen is left out, from the start if after is too;
+//                                                 finding after costs O(log n), or one hash probe for an indexed category,
+//                                                 but a walk of the list, O(n), for an edited category that is not indexed)
+// Clients may pipeline : every complete line already received is answered in one batch and sent with a single write.
+// A request that fails (a category that cannot be read, no memory...) is answered ERR <reason>, and when the edits of a
+// batch cannot be made durable every reply of the batch becomes ERR <reason>; the server and its other clients go on.
+// A client that shuts down its side of the socket still receives every reply before the server closes it.
+class WordServer
+{
+private:
+    struct Client
+    {
+        std::string in;  // bytes received but not yet processed (at most one partial line after a batch)
+        std::string out; // replies not yet written to the socket
+        bool closing;    // the peer sends nothing more : closed once out is written
+        Client() : closing(false) {}
+    };
+
+    WordCatVec &vocabulary;
+    int listen_fd;
+    int epoll_fd;
+    std::unordered_map<int, Client> clients;
+
+    void acceptClients();
+    void readClient(int fd);
+    void writeClient(int fd);
+    void closeClient(int fd);
+    size_t executeLines(Client &client); // answers the complete lines of client.in, returns how many
+    void dispatch(const char *line, size_t length, std::string &reply);
+
+public:
+    static const size_t MAX_LINE = 1 << 20; // a client sending a longer line is disconnected
+
+    WordServer(WordCatVec &vocabulary);
+    WordServer(const WordServer &) = delete;
+    WordServer &operator=(const WordServer &) = delete;
+    ~WordServer();
+
+    void serve(const char *socket_path); // blocks until SIGINT / SIGTERM
+    void execute(const char *line, size_t length, std::string &reply); // answers one request line, also used by batch mode; never throws
+};
+
+#endif // WORDSERVER_H
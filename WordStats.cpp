@@ -0,0 +1,135 @@
+#include "WordStats.h"
+#include "Utf8.h"
+#include <cstring>
+using namespace std;
+
+// Default constructor : every counter at zero
+WordStats::WordStats()
+{
+    clear();
+}
+
+// 0 to 25 for a letter of the English alphabet (after case folding), 26 for anything else
+size_t WordStats::letterBucket(const char *word, size_t length)
+{
+    uint32_t letter = utf8FirstLetter(word, length);
+    return letter >= 'a' && letter <= 'z' ? letter - 'a' : LETTERS - 1;
+}
+
+void WordStats::add(const char *word, size_t length)
+{
+    ++count;
+    total_bytes += length;
+    ++lengths[length < MAX_LENGTH ? length : MAX_LENGTH];
+    ++letters[letterBucket(word, length)];
+}
+
+void WordStats::remove(const char *word, size_t length)
+{
+    --count;
+    total_bytes -= length;
+    --lengths[length < MAX_LENGTH ? length : MAX_LENGTH];
+    --letters[letterBucket(word, length)];
+}
+
+void WordStats::clear()
+{
+    count = 0;
+    total_bytes = 0;
+    memset(lengths, 0, sizeof(lengths));
+    memset(letters, 0, sizeof(letters));
+}
+
+// total += cat.stats(); every counter is a sum, so aggregating costs the same whatever the size of the categories
+WordStats &WordStats::operator+=(const WordStats &other)
+{
+    count += other.count;
+    total_bytes += other.total_bytes;
+    for (size_t i = 0; i <= MAX_LENGTH; ++i)
+    {
+        lengths[i] += other.lengths[i];
+    }
+    for (size_t i = 0; i < LETTERS; ++i)
+    {
+        letters[i] += other.letters[i];
+    }
+    return *this;
+}
+
+void WordStats::save(uint64_t *fields) const
+{
+    fields[0] = count;
+    fields[1] = total_bytes;
+    for (size_t i = 0; i <= MAX_LENGTH; ++i)
+    {
+        fields[2 + i] = lengths[i];
+    }
+    for (size_t i = 0; i < LETTERS; ++i)
+    {
+        fields[3 + MAX_LENGTH + i] = letters[i];
+    }
+}
+
+void WordStats::restore(const uint64_t *fields)
+{
+    count = fields[0];
+    total_bytes = fields[1];
+    for (size_t i = 0; i <= MAX_LENGTH; ++i)
+    {
+        lengths[i] = fields[2 + i];
+    }
+    for (size_t i = 0; i < LETTERS; ++i)
+    {
+        letters[i] = fields[3 + MAX_LENGTH + i];
+    }
+}
+
+size_t WordStats::words() const
+{
+    return count;
+}
+
+size_t WordStats::bytes() const
+{
+    return total_bytes;
+}
+
+size_t WordStats::withLength(size_t length) const
+{
+    return lengths[length < MAX_LENGTH ? length : MAX_LENGTH];
+}
+
+size_t WordStats::startingWith(char letter) const
+{
+    return letters[letterBucket(&letter, 1)];
+}
+
+// Words: 12 / Bytes: 80 / Lengths: 3:4 5:8 / Letters: a:2 c:10 ; empty buckets are left out
+void WordStats::print(ostream &os, char separator) const
+{
+    os << "Words: " << count << separator;
+    os << "Bytes: " << total_bytes << separator;
+    os << "Lengths:";
+    for (size_t i = 0; i <= MAX_LENGTH; ++i)
+    {
+        if (lengths[i] != 0)
+        {
+            os << ' ' << i << (i == MAX_LENGTH ? "+:" : ":") << lengths[i];
+        }
+    }
+    os << separator << "Letters:";
+    for (size_t i = 0; i < LETTERS; ++i)
+    {
+        if (letters[i] != 0)
+        {
+            if (i == LETTERS - 1)
+            {
+                os << " other:" << letters[i];
+            }
+            else
+            {
+                os << ' ' << static_cast<char>('a' + i) << ':' << letters[i];
+            }
+        }
+    }
+}
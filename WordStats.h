@@ -0,0 +1,42 @@
+#ifndef WORDSTATS_H
+#define WORDSTATS_H
+
+#include <cstddef>
+#include <iostream>
+#include <stdint.h>
+
+// Counters kept up to date as words come and go, so statistics never need a walk over the words :
+// number of words, total bytes, how many words have each length and how many start with each letter.
+// Adding the stats of several categories gives the stats of all of them together.
+class WordStats
+{
+public:
+    static const size_t MAX_LENGTH = 32; // words of MAX_LENGTH bytes or more share the last length bucket
+    static const size_t LETTERS = 27;    // 'a' to 'z' (case folded), then everything else
+    static const size_t FIELDS = 2 + (MAX_LENGTH + 1) + LETTERS; // counters written by save(), e.g. into a file
+
+    WordStats();
+
+    void add(const char *word, size_t length);
+    void remove(const char *word, size_t length); // word must have been added
+    void clear();
+    WordStats &operator+=(const WordStats &other);
+    void save(uint64_t *fields) const;     // FIELDS counters : words, bytes, the lengths, the letters
+    void restore(const uint64_t *fields); // the counters save() wrote, no walk over the words
+
+    size_t words() const;
+    size_t bytes() const;                  // characters only, no terminators
+    size_t withLength(size_t length) const; // length >= MAX_LENGTH gives the last bucket
+    size_t startingWith(char letter) const; // either case, any other character gives the "other" bucket
+    void print(std::ostream &os, char separator = '\n') const; // one line per statistic, lines split by separator
+
+private:
+    size_t count;
+    size_t total_bytes;
+    size_t lengths[MAX_LENGTH + 1];
+    size_t letters[LETTERS];
+
+    static size_t letterBucket(const char *word, size_t length);
+};
+
+#endif // WORDSTATS_H
@@ -0,0 +1,53 @@
+#ifndef WORDVIEW_H
+#define WORDVIEW_H
+
+#include <cstddef>
+
+// Non-owning, constexpr-capable view of a word : constexpr WordView w("hello");
+// Used for dictionaries that are fixed at build time : the words live in the program image,
+// so a category made of WordViews needs no parsing, no sorting and no heap at startup.
+class WordView
+{
+private:
+    const char *text;
+    size_t size;
+
+    // strcmp order (bytes compared as unsigned char), one character per step so it stays a C++11 constexpr
+    static constexpr int compareFrom(const char *a, size_t a_length, const char *b, size_t b_length, size_t i)
+    {
+        return i == a_length ? (i == b_length ? 0 : -1)
+               : i == b_length ? 1
+               : static_cast<unsigned char>(a[i]) != static_cast<unsigned char>(b[i])
+                   ? (static_cast<unsigned char>(a[i]) < static_cast<unsigned char>(b[i]) ? -1 : 1)
+                   : compareFrom(a, a_length, b, b_length, i + 1);
+    }
+
+public:
+    constexpr WordView() : text(""), size(0) {}
+    template <size_t N>
+    constexpr WordView(const char (&literal)[N]) : text(literal), size(N - 1) {} // a string literal, without its '\0'
+    constexpr WordView(const char *data, size_t length) : text(data), size(length) {}
+
+    constexpr const char *c_str() const { return text; } // null terminated when made from a literal
+    constexpr size_t length() const { return size; }
+    constexpr int compare(const WordView &other) const { return compareFrom(text, size, other.text, other.size, 0); }
+};
+
+// A category whose words are a sorted WordView array known at compile time
+struct StaticCategory
+{
+    const char *name;
+    const WordView *words;
+    size_t count;
+};
+
+// True if words[low, high) is sorted; splits the range in two so the recursion depth stays logarithmic
+constexpr bool wordViewsSorted(const WordView *words, size_t low, size_t high)
+{
+    return high - low < 2 ? true
+                          : wordViewsSorted(words, low, low + (high - low) / 2) &&
+                                wordViewsSorted(words, low + (high - low) / 2, high) &&
+                                words[low + (high - low) / 2 - 1].compare(words[low + (high - low) / 2]) <= 0;
+}
+
+#endif // WORDVIEW_H
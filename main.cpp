@@ -1,13 +1,226 @@
 #include "WordCatVec.h"
+#include "WordServer.h"
+#include "WordLog.h"
+#include "Trace.h"
+#include <cstring>
 
-void testWordCatVec()
+// --log <base> : recover from <base>.snap and <base>.log, then log every edit there
+bool openLog(WordCatVec &word_cat_vec, WordLog &log, const char *log_base)
+{
+    if (log_base == nullptr)
+    {
+        return true;
+    }
+    try
+    {
+        log.open(log_base, word_cat_vec);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << '\n';
+        return false;
+    }
+    word_cat_vec.attachLog(&log);
+    return true;
+}
+
+// --attach <file> : the categories of a shared dictionary first, then the vocabulary files.
+// With --log the vocabulary recovered from the log comes first : the files are read again on every start, so they are
+// loaded aside, unlogged, and only a category the log does not hold yet is added (and logged, so it is recovered next time)
+bool loadVocabulary(WordCatVec &word_cat_vec, int file_count, char *files[], bool lazy, const char *shared_file, bool logged)
+{
+    WordCatVec startup;
+    WordCatVec &target = logged ? startup : word_cat_vec;
+    if (shared_file != nullptr)
+    {
+        try
+        {
+            target.attachShared(shared_file);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << e.what() << '\n';
+            return false;
+        }
+    }
+    for (int i = 0; i < file_count; ++i)
+    {
+        if (lazy)
+        {
+            target.loadFromFileLazily(files[i]);
+        }
+        else
+        {
+            target.loadFromFile(files[i]);
+        }
+    }
+    if (logged)
+    {
+        word_cat_vec.addMissingCategories(startup);
+    }
+    return true;
+}
+
+void testWordCatVec(const char *log_base, const char *shared_file)
 {
     WordCatVec word_cat_vec;
+    WordLog log;
+    if (!openLog(word_cat_vec, log, log_base) || !loadVocabulary(word_cat_vec, 0, nullptr, false, shared_file, log_base != nullptr))
+    {
+        return;
+    }
     word_cat_vec.run();
 }
 
-int main()
+// ./output --serve <socket path> [vocabulary files...] : load the files once and answer queries over the socket
+int serveWordCatVec(const char *socket_path, int file_count, char *files[], const char *log_base, bool lazy, const char *shared_file)
+{
+    WordCatVec word_cat_vec;
+    WordLog log;
+    if (!openLog(word_cat_vec, log, log_base))
+    {
+        return 1;
+    }
+    if (!loadVocabulary(word_cat_vec, file_count, files, lazy, shared_file, log_base != nullptr))
+    {
+        return 1;
+    }
+    try
+    {
+        word_cat_vec.commitLog();
+        WordServer server(word_cat_vec);
+        server.serve(socket_path);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
+
+// ./output --batch [vocabulary files...] : answer the server protocol read line by line from stdin, replies on stdout
+int batchWordCatVec(int file_count, char *files[], const char *log_base, bool lazy, const char *shared_file)
+{
+    WordCatVec word_cat_vec;
+    WordLog log;
+    if (!openLog(word_cat_vec, log, log_base))
+    {
+        return 1;
+    }
+    if (!loadVocabulary(word_cat_vec, file_count, files, lazy, shared_file, log_base != nullptr))
+    {
+        return 1;
+    }
+    WordServer commands(word_cat_vec); // no socket is opened unless serve() is called
+    std::string line;
+    std::string reply;
+    try
+    {
+        while (std::getline(std::cin, line))
+        {
+            commands.execute(line.data(), line.size(), reply);
+            if (reply.size() >= 65536) // write replies in large pieces
+            {
+                word_cat_vec.commitLog(); // edits are durable before they are acknowledged
+                std::cout << reply;
+                reply.clear();
+            }
+        }
+        word_cat_vec.commitLog();
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    std::cout << reply << std::flush;
+    return 0;
+}
+
+// ./output --publish <shared file> [vocabulary files...] : load the files and write them as a shared dictionary
+int publishWordCatVec(const char *shared_file, int file_count, char *files[])
 {
-    testWordCatVec();
+    WordCatVec word_cat_vec;
+    for (int i = 0; i < file_count; ++i)
+    {
+        word_cat_vec.loadFromFile(files[i]);
+    }
+    try
+    {
+        word_cat_vec.publishShared(shared_file);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
     return 0;
 }
+
+// ./output [--log <base>] [--lazy] [--attach <file>] [--trace <file>] [--batch ... | --serve ... | --publish ...]
+// --lazy : the vocabulary files are only scanned for their category headers, each category is read on first use
+// --attach : the categories of a dictionary written by --publish are read in place, shared with every process attached to it
+// --trace : records a timeline of the operations and load phases, written to <file> as trace-event JSON on exit
+int main(int argc, char *argv[])
+{
+    const char *log_base = nullptr;
+    const char *trace_file = nullptr;
+    const char *shared_file = nullptr;
+    bool lazy = false;
+    while (argc >= 2)
+    {
+        if (argc >= 3 && strcmp(argv[1], "--trace") == 0)
+        {
+            trace_file = argv[2];
+            Trace::enable();
+            argc -= 2;
+            argv += 2;
+            continue;
+        }
+        if (argc >= 3 && strcmp(argv[1], "--log") == 0)
+        {
+            log_base = argv[2];
+            argc -= 2;
+            argv += 2;
+        }
+        else if (argc >= 3 && strcmp(argv[1], "--attach") == 0)
+        {
+            shared_file = argv[2];
+            argc -= 2;
+            argv += 2;
+        }
+        else if (strcmp(argv[1], "--lazy") == 0)
+        {
+            lazy = true;
+            argc -= 1;
+            argv += 1;
+        }
+        else
+        {
+            break;
+        }
+    }
+    int status = 0;
+    if (argc >= 2 && strcmp(argv[1], "--batch") == 0)
+    {
+        status = batchWordCatVec(argc - 2, argv + 2, log_base, lazy, shared_file);
+    }
+    else if (argc >= 3 && strcmp(argv[1], "--serve") == 0)
+    {
+        status = serveWordCatVec(argv[2], argc - 3, argv + 3, log_base, lazy, shared_file);
+    }
+    else if (argc >= 3 && strcmp(argv[1], "--publish") == 0)
+    {
+        status = publishWordCatVec(argv[2], argc - 3, argv + 3);
+    }
+    else
+    {
+        testWordCatVec(log_base, shared_file);
+    }
+    if (trace_file != nullptr && !Trace::exportJson(trace_file))
+    {
+        std::cerr << "Failed to write trace to " << trace_file << '\n';
+    }
+    return status;
+}
@@ -0,0 +1,90 @@
+// The Bloom filter : never a false "no", and at capacity the measured false-positive rate stays near the configured one
+// ./bloom_filter_test ; prints each failed check
+#include "BloomFilter.h"
+#include "WordCat.h"
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    int failures = 0;
+
+    void expect(bool ok, const char *what)
+    {
+        if (!ok)
+        {
+            cout << "FAIL: " << what << endl;
+            ++failures;
+        }
+    }
+
+    uint64_t key(size_t i) // the hash of a word, as the categories add them
+    {
+        return Word(("word" + to_string(i)).c_str()).hash();
+    }
+
+    void testRate(double rate)
+    {
+        const size_t keys = 20000;
+        const size_t probes = 1000000; // about 100 false positives at the lowest rate tested
+        BloomFilter filter(keys, rate);
+        for (size_t i = 0; i < keys; ++i)
+        {
+            filter.add(key(i));
+        }
+        bool all_found = true;
+        for (size_t i = 0; i < keys; ++i)
+        {
+            all_found = all_found && filter.mightContain(key(i));
+        }
+        expect(all_found, "every key added is found");
+
+        size_t false_positives = 0;
+        for (size_t i = keys; i < keys + probes; ++i)
+        {
+            false_positives += filter.mightContain(key(i)) ? 1 : 0;
+        }
+        double measured = static_cast<double>(false_positives) / probes;
+        if (measured > 1.5 * rate) // the filter is sized for the rate with blocks, what is left over is sampling noise
+        {
+            cout << "rate " << rate << " measured " << measured << endl;
+        }
+        expect(measured <= 1.5 * rate, "the false-positive rate at capacity stays near the configured one");
+    }
+
+    bool rejects(double rate)
+    {
+        try
+        {
+            WordCat::setFilterFalsePositiveRate(rate);
+            return false;
+        }
+        catch (const runtime_error &)
+        {
+            return true;
+        }
+    }
+}
+
+int main()
+{
+    testRate(0.1);
+    testRate(0.01);
+    testRate(0.001);
+    testRate(0.0001);
+
+    BloomFilter empty;
+    expect(empty.mightContain(key(0)), "an empty filter says maybe");
+
+    double rate = WordCat::filterFalsePositiveRate();
+    expect(rejects(0.0) && rejects(1.0) && rejects(-0.5) && rejects(2.0), "rates outside (0, 1) are rejected");
+    expect(WordCat::filterFalsePositiveRate() == rate, "a rejected rate leaves the rate as it was");
+    expect(!rejects(0.05) && WordCat::filterFalsePositiveRate() == 0.05, "a rate inside (0, 1) is taken");
+    WordCat::setFilterFalsePositiveRate(rate);
+
+    if (failures == 0)
+    {
+        cout << "bloom filter test passed" << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
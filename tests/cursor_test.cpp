@@ -0,0 +1,174 @@
+// Cursors and pages over every form of a category : seek lands on the first word >= key in the list, front-coded,
+// frozen and indexed forms alike, and a page (the G request) resumes after the words it showed, edited or not
+// ./cursor_test ; prints each failed check
+#include "WordCat.h"
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    int failures = 0;
+
+    void expect(bool ok, const char *what)
+    {
+        if (!ok)
+        {
+            cout << "FAIL: " << what << endl;
+            ++failures;
+        }
+    }
+
+    // Words sharing long prefixes, so the front-coded form has something to strip, and a few copies of some of them
+    vector<string> sampleWords()
+    {
+        vector<string> words;
+        const char *stems[] = {"a", "ab", "abc", "b", "ban", "band", "bandana", "c", "ca", "cat", "catalog", "z"};
+        for (size_t s = 0; s < sizeof(stems) / sizeof(stems[0]); ++s)
+        {
+            for (int i = 0; i < 40; ++i)
+            {
+                words.push_back(stems[s] + to_string(i));
+            }
+            words.push_back(stems[s]);
+        }
+        words.push_back("cat");
+        words.push_back("cat");
+        sort(words.begin(), words.end());
+        return words;
+    }
+
+    WordCat category(const vector<string> &words)
+    {
+        WordCat cat(Word("sample"));
+        for (size_t i = 0; i < words.size(); ++i)
+        {
+            cat.insertWord(Word(words[i].c_str()));
+        }
+        return cat;
+    }
+
+    string walk(WordCat::Cursor &cursor, size_t count) // the next count words, space separated
+    {
+        string out;
+        for (size_t i = 0; i < count && cursor.valid(); ++i, cursor.next())
+        {
+            out.append(cursor.data(), cursor.length()) += ' ';
+        }
+        return out;
+    }
+
+    string expected(const vector<string> &words, vector<string>::const_iterator from, size_t count)
+    {
+        string out;
+        for (size_t i = 0; i < count && from != words.end(); ++i, ++from)
+        {
+            out += *from + ' ';
+        }
+        return out;
+    }
+
+    void testSeek(const WordCat &cat, const vector<string> &words, const char *form)
+    {
+        vector<string> keys(words);
+        keys.push_back("");
+        keys.push_back("0");
+        keys.push_back("zz");
+        for (size_t i = 0; i < words.size(); i += 7)
+        {
+            keys.push_back(words[i] + "0"); // just after a word
+            keys.push_back(words[i].substr(0, words[i].size() - 1)); // just before it
+        }
+        bool from_start = true;
+        bool forward = true;
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            vector<string>::const_iterator wanted = lower_bound(words.begin(), words.end(), keys[i]);
+            WordCat::Cursor cursor(cat);
+            cursor.seek(keys[i].data(), keys[i].size());
+            from_start = from_start && walk(cursor, 3) == expected(words, wanted, 3);
+
+            // from part way through : a key behind the cursor leaves it where it is
+            WordCat::Cursor moved(cat);
+            string middle = words[words.size() / 2];
+            moved.seek(middle.data(), middle.size());
+            moved.seek(keys[i].data(), keys[i].size());
+            vector<string>::const_iterator after = max(wanted, lower_bound(words.begin(), words.end(), middle));
+            forward = forward && walk(moved, 3) == expected(words, after, 3);
+        }
+        if (!from_start || !forward)
+        {
+            cout << "form: " << form << endl;
+        }
+        expect(from_start, "seek from the first word lands on the first word >= key");
+        expect(forward, "seek from the middle only moves forward");
+    }
+
+    string pages(const WordCat &cat, WordCat::Page &page, size_t page_size)
+    {
+        ostringstream shown;
+        while (cat.printPage(page, page_size, shown) > 0)
+        {
+        }
+        return shown.str();
+    }
+
+    void testPages(WordCat &cat, const vector<string> &words)
+    {
+        string all = expected(words, words.begin(), words.size());
+        WordCat::Page page(cat);
+        expect(pages(cat, page, 7) == all, "pages of 7 show every word once");
+
+        WordCat::Page resumed(cat, "cat", 3, 2); // G sample 10 cat 2 : after two of the three copies of cat
+        ostringstream shown;
+        cat.printPage(resumed, 2, shown);
+        expect(shown.str() == "cat cat0 ", "a page resumes after the copies of a word it already showed");
+
+        WordCat::Page edited(cat);
+        ostringstream first;
+        cat.printPage(edited, 5, first); // a a0 a1 a10 a11
+        cat.insertWord(Word("a0a"));     // before the last word shown : not on the next page
+        cat.insertWord(Word("a11a"));    // after it : on the next page
+        cat.removeWord(Word("a12"));     // the next word : gone
+        ostringstream second;
+        cat.printPage(edited, 3, second);
+        expect(first.str() == "a a0 a1 a10 a11 " && second.str() == "a11a a13 a14 ", "a page carries on after an edit");
+    }
+}
+
+int main()
+{
+    vector<string> words = sampleWords();
+
+    WordCat list = category(words);
+    testSeek(list, words, "list");
+    try
+    {
+        list.enableIndex(); // seek asks the index, one probe instead of a walk
+        testSeek(list, words, "indexed list");
+    }
+    catch (const runtime_error &) // the unrolled list has no index
+    {
+    }
+
+    WordCat compressed = category(words);
+    compressed.compress();
+    testSeek(compressed, words, "front-coded");
+
+    WordCat frozen = category(words);
+    frozen.freeze();
+    testSeek(frozen, words, "frozen");
+
+    WordCat paged = category(words);
+    testPages(paged, words);
+    WordCat paged_compressed = category(words);
+    paged_compressed.compress();
+    testPages(paged_compressed, words); // the edits make it editable again
+
+    if (failures == 0)
+    {
+        cout << "cursor test passed" << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
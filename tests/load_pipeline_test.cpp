@@ -0,0 +1,111 @@
+// The load pipeline : the batches give back the file's categories and words in order, lines split across read blocks
+// included, with empty and invalid lines skipped; stopping before the end does not hang
+// ./load_pipeline_test ; writes load_pipeline_test.txt in the current directory, prints each failed check
+#include "LoadPipeline.h"
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+    const char *FILENAME = "load_pipeline_test.txt";
+    const size_t MANY = 30000; // words of the second category : several read blocks and several batches
+
+    int failures = 0;
+
+    void expect(bool ok, const char *what)
+    {
+        if (!ok)
+        {
+            cout << "FAIL: " << what << endl;
+            ++failures;
+        }
+    }
+
+    string numbered(size_t i)
+    {
+        return "word" + to_string(i);
+    }
+
+    void writeInput()
+    {
+        ofstream out(FILENAME, ios::binary | ios::trunc);
+        out << "ignored before the first header\n";
+        out << "#animals\r\n";
+        out << "cat\r\n\n";
+        out << "\xff\xfe\n"; // not UTF-8
+        out << "dog\n";
+        out << "#numbers\n";
+        for (size_t i = 0; i < MANY; ++i)
+        {
+            out << numbered(i) << '\n';
+        }
+        out << "#last\n";
+        out << "no newline";
+    }
+}
+
+int main()
+{
+    writeInput();
+    int fd = open(FILENAME, O_RDONLY);
+    expect(fd != -1, "open the input");
+
+    vector<string> headers;
+    vector<vector<string>> categories;
+    bool batches_bounded = true;
+    size_t skipped = 0;
+    {
+        LoadPipeline pipeline(fd);
+        LoadPipeline::Batch batch;
+        while (pipeline.next(batch))
+        {
+            if (batch.kind == LoadPipeline::Batch::HEADER)
+            {
+                headers.push_back(batch.name.c_str());
+                categories.push_back(vector<string>());
+            }
+            else
+            {
+                batches_bounded = batches_bounded && !batch.words.empty() && batch.words.size() <= LoadPipeline::BATCH_WORDS;
+                for (size_t i = 0; i < batch.words.size(); ++i)
+                {
+                    categories.back().push_back(batch.words[i].c_str());
+                }
+            }
+        }
+        skipped = pipeline.skipped();
+    }
+
+    expect(headers.size() == 3 && headers[0] == "animals" && headers[1] == "numbers" && headers[2] == "last",
+           "every header, without '#' or '\\r'");
+    expect(categories.size() == 3 && categories[0].size() == 2 && categories[0][0] == "cat" && categories[0][1] == "dog",
+           "empty and invalid lines are skipped");
+    bool in_order = categories.size() == 3 && categories[1].size() == MANY;
+    for (size_t i = 0; in_order && i < MANY; ++i)
+    {
+        in_order = categories[1][i] == numbered(i);
+    }
+    expect(in_order, "every word, in file order, across read blocks");
+    expect(categories.size() == 3 && categories[2].size() == 1 && categories[2][0] == "no newline", "the last line needs no newline");
+    expect(batches_bounded, "batches are never empty or larger than BATCH_WORDS");
+    expect(skipped == 1, "the invalid line is counted");
+
+    lseek(fd, 0, SEEK_SET);
+    {
+        LoadPipeline pipeline(fd);
+        LoadPipeline::Batch batch;
+        expect(pipeline.next(batch), "a batch");
+    } // stops the threads with most of the input unread
+    close(fd);
+
+    remove(FILENAME);
+    if (failures == 0)
+    {
+        cout << "load pipeline test passed" << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+// The query cache : a result never outlives an edit of a category it depends on, and an edit only computes again
+// the part of the edited category
+// ./query_cache_test ; prints each failed check
+#include "WordCatVec.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+    int failures = 0;
+
+    void expect(bool ok, const char *what)
+    {
+        if (!ok)
+        {
+            cout << "FAIL: " << what << endl;
+            ++failures;
+        }
+    }
+
+    // Categories as QueryCache::get() sees them : each one contributes its word, and counts how often it was asked
+    struct Categories
+    {
+        vector<string> words;
+        vector<unsigned long> versions;
+        unsigned long edits;
+        mutable size_t computed;
+
+        Categories() : edits(0), computed(0) {}
+
+        void add(const string &word)
+        {
+            words.push_back(word);
+            versions.push_back(++edits);
+        }
+
+        void edit(size_t i, const string &word)
+        {
+            words[i] = word;
+            versions[i] = ++edits;
+        }
+
+        unsigned long stamp() const { return edits; }
+        size_t count() const { return words.size(); }
+        unsigned long version(size_t i) const { return versions[i]; }
+        void compute(size_t i, QueryCache::Result &part) const
+        {
+            ++computed;
+            part.push_back(words[i]);
+        }
+    };
+
+    QueryCache::Result result(const char *a, const char *b = nullptr, const char *c = nullptr)
+    {
+        QueryCache::Result expected(1, a);
+        if (b != nullptr)
+        {
+            expected.push_back(b);
+        }
+        if (c != nullptr)
+        {
+            expected.push_back(c);
+        }
+        return expected;
+    }
+
+    void testParts()
+    {
+        QueryCache cache(2);
+        Categories categories;
+        categories.add("cat");
+        categories.add("dog");
+        categories.add("cow");
+
+        expect(cache.get("q", categories) == result("cat", "dog", "cow") && categories.computed == 3, "a miss computes every part");
+        expect(cache.get("q", categories) == result("cat", "dog", "cow") && categories.computed == 3, "a hit computes nothing");
+        expect(cache.hits() == 1 && cache.misses() == 1, "one hit, one miss");
+
+        categories.edit(1, "duck");
+        expect(cache.get("q", categories) == result("cat", "duck", "cow") && categories.computed == 4, "an edit computes only its part");
+
+        ++categories.edits; // an edit somewhere else : the stamp moves, no version here does
+        expect(cache.get("q", categories) == result("cat", "duck", "cow") && categories.computed == 4,
+               "a moved stamp with the same versions is still a hit");
+        expect(cache.hits() == 2 && cache.misses() == 2, "hits and misses after the edits");
+
+        categories.add("ant");
+        categories.computed = 0;
+        expect(cache.get("q", categories).size() == 4 && categories.computed == 4, "a new category computes every part");
+
+        cache.get("r", categories);
+        cache.get("s", categories); // capacity 2 : q is evicted
+        categories.computed = 0;
+        cache.get("q", categories);
+        expect(categories.computed == 4 && cache.length() == 2, "the least recently used result is evicted");
+
+        cache.setCapacity(0);
+        categories.computed = 0;
+        cache.get("q", categories);
+        cache.get("q", categories);
+        expect(categories.computed == 8 && cache.length() == 0, "capacity 0 computes every time");
+    }
+
+    QueryCache::Result containing(const WordCatVec &vocabulary, const char *word)
+    {
+        return vocabulary.categoriesContaining(word);
+    }
+
+    void testVocabulary()
+    {
+        WordCatVec vocabulary;
+        WordCat animals(Word("animals"));
+        animals.insertWord(Word("cat"));
+        animals.insertWord(Word("dog"));
+        vocabulary.addCategory(move(animals));
+        WordCat colours(Word("colours"));
+        colours.insertWord(Word("red"));
+        vocabulary.addCategory(move(colours));
+
+        expect(containing(vocabulary, "cat") == result("animals"), "search");
+        vocabulary.insertWord("colours", Word("cat"));
+        expect(containing(vocabulary, "cat") == result("animals", "colours"), "an insert is seen");
+        vocabulary.removeWord("animals", Word("cat"));
+        expect(containing(vocabulary, "cat") == result("colours"), "a removal is seen");
+        vocabulary.getCategory("colours")->modifyCategoryName(Word("hues"));
+        expect(containing(vocabulary, "cat") == result("hues"), "a rename is seen");
+        vocabulary.removeCategory("hues");
+        expect(containing(vocabulary, "cat").empty(), "a removed category is gone");
+        WordCat pets(Word("pets"));
+        pets.insertWord(Word("cat"));
+        vocabulary.addCategory(move(pets));
+        expect(containing(vocabulary, "cat") == result("pets"), "an added category is seen");
+        vocabulary.clearCategory("pets");
+        expect(containing(vocabulary, "cat").empty(), "a clear is seen");
+
+        expect(vocabulary.wordsWithPrefix("d") == result("dog"), "prefix");
+        vocabulary.insertWord("animals", Word("duck"));
+        expect(vocabulary.wordsWithPrefix("d") == result("dog", "duck"), "an insert is seen by a prefix query");
+        vocabulary.getCategory("animals")->compress();
+        expect(vocabulary.wordsWithPrefix("d") == result("dog", "duck"), "a change of form gives the same words");
+    }
+}
+
+int main()
+{
+    testParts();
+    testVocabulary();
+    if (failures == 0)
+    {
+        cout << "query cache test passed" << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
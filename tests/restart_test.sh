@@ -0,0 +1,31 @@
+#!/bin/sh
+# Restarting with --log and the same vocabulary file must neither duplicate the file's categories nor lose the edits
+# made since the last start : ./restart_test.sh <path to output>
+program="$1"
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+printf '#animals\ncat\ndog\n#colours\nred\n' > "$dir/in.txt"
+
+run() # requests on stdin, replies on stdout
+{
+    "$program" --log "$dir/db" --batch "$dir/in.txt"
+}
+
+expect() # expected reply, actual reply, what was asked
+{
+    if [ "$1" != "$2" ]; then
+        echo "FAIL: $3 : expected '$1', got '$2'"
+        exit 1
+    fi
+}
+
+for start in 1 2 3; do
+    reply=$(printf 'N 10\n' | run)
+    if [ "$start" = 1 ]; then
+        expect "$(printf 'OK\tcat\tanimals\tdog\tanimals\tred\tcolours')" "$reply" "words after the first start"
+        printf 'A animals\tcow\n' | run > /dev/null
+    else
+        expect "$(printf 'OK\tcat\tanimals\tcow\tanimals\tdog\tanimals\tred\tcolours')" "$reply" "words after restart $start"
+    fi
+done
+echo "restart test passed"
@@ -0,0 +1,170 @@
+// The socket server : pipelined requests, replies still delivered after the client shuts down its side,
+// an overlong line only drops its own client, a lazily loaded file that went away is an ERR reply until it is back
+// ./server_test ; serves on server_test.sock in the current directory from a child process, prints each failed check
+#include "WordServer.h"
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+    const char *SOCKET_PATH = "server_test.sock";
+    const char *LAZY_PATH = "server_test.txt"; // read lazily by the server
+
+    void writeLazyFile()
+    {
+        ofstream out(LAZY_PATH, ios::trunc);
+        out << "#pets\ncat\nhamster\n";
+    }
+
+    int failures = 0;
+
+    void expect(bool ok, const char *what)
+    {
+        if (!ok)
+        {
+            cout << "FAIL: " << what << endl;
+            ++failures;
+        }
+    }
+
+    int connectServer() // retries while the child is still starting
+    {
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strcpy(address.sun_path, SOCKET_PATH);
+        for (int attempt = 0; attempt < 200; ++attempt)
+        {
+            int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0)
+            {
+                return fd;
+            }
+            close(fd);
+            usleep(10000);
+        }
+        return -1;
+    }
+
+    bool sendAll(int fd, const string &bytes)
+    {
+        size_t sent = 0;
+        while (sent < bytes.size())
+        {
+            ssize_t n = send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0)
+            {
+                return false;
+            }
+            sent += n;
+        }
+        return true;
+    }
+
+    string readAll(int fd) // until the server closes the connection
+    {
+        string received;
+        char buffer[4096];
+        ssize_t n;
+        while ((n = read(fd, buffer, sizeof(buffer))) > 0)
+        {
+            received.append(buffer, n);
+        }
+        return received;
+    }
+
+    // One request, one reply line, the connection stays open
+    string ask(int fd, const string &request)
+    {
+        if (!sendAll(fd, request + "\n"))
+        {
+            return "";
+        }
+        string reply;
+        char c;
+        while (read(fd, &c, 1) == 1 && c != '\n')
+        {
+            reply += c;
+        }
+        return reply;
+    }
+}
+
+int main()
+{
+    writeLazyFile();
+    pid_t child = fork();
+    if (child == 0)
+    {
+        WordCatVec vocabulary;
+        vocabulary.loadFromFileLazily(LAZY_PATH); // only the header line is read here
+        WordCat animals(Word("animals"));
+        animals.insertWord(Word("cat"));
+        animals.insertWord(Word("dog"));
+        vocabulary.addCategory(move(animals));
+        WordServer server(vocabulary);
+        server.serve(SOCKET_PATH);
+        _exit(0);
+    }
+
+    int fd = connectServer();
+    expect(fd != -1, "connect");
+    if (fd != -1)
+    {
+        remove(LAZY_PATH);
+        expect(ask(fd, "S cat").compare(0, 4, "ERR ") == 0, "a lazy file removed after the load is an ERR reply");
+        writeLazyFile();
+        expect(ask(fd, "S cat") == "OK\tpets\tanimals", "the category is read once the file is back");
+        close(fd);
+    }
+
+    fd = connectServer();
+    if (fd != -1)
+    {
+        // many pipelined requests, then a half-close : every reply must still arrive before the server closes
+        string requests;
+        string expected;
+        for (int i = 0; i < 200000; ++i) // more replies than the socket buffers hold
+        {
+            requests += "S cat\nA animals\tcow\n";
+            expected += "OK\tpets\tanimals\nOK\n";
+        }
+        expect(sendAll(fd, requests), "send the pipelined requests");
+        shutdown(fd, SHUT_WR);
+        expect(readAll(fd) == expected, "every reply arrives after the client shuts down its side");
+        close(fd);
+    }
+
+    fd = connectServer();
+    if (fd != -1)
+    {
+        string line(WordServer::MAX_LINE + 4096, 'x'); // no newline : the server drops this client
+        sendAll(fd, line);
+        readAll(fd);
+        close(fd);
+    }
+    fd = connectServer();
+    expect(fd != -1 && ask(fd, "S dog") == "OK\tanimals", "the server goes on after dropping a client");
+    if (fd != -1)
+    {
+        close(fd);
+    }
+
+    remove(LAZY_PATH);
+    kill(child, SIGTERM);
+    int status;
+    waitpid(child, &status, 0);
+    expect(WIFEXITED(status) && WEXITSTATUS(status) == 0, "the server stops on SIGTERM");
+    if (failures == 0)
+    {
+        cout << "server test passed" << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
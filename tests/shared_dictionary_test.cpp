@@ -0,0 +1,118 @@
+// A shared dictionary file that was damaged after publish must be rejected by attach, not read out of bounds
+// ./shared_dictionary_test ; writes shared_dictionary_test.shm in the current directory, prints each failed check
+#include "WordCatVec.h"
+#include <fstream>
+#include <iterator>
+#include <stdint.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace
+{
+    const char *FILENAME = "shared_dictionary_test.shm";
+    const size_t HEADER = 32;        // magic, size, category count, checksum
+    const size_t ENTRY_STARTS = 40;  // offset of the starts array, in the first category entry
+    const size_t ENTRY_LENGTHS = 48; // offset of the lengths array
+
+    int failures = 0;
+
+    void expect(bool ok, const char *what)
+    {
+        if (!ok)
+        {
+            cout << "FAIL: " << what << endl;
+            ++failures;
+        }
+    }
+
+    string readFile()
+    {
+        ifstream in(FILENAME, ios::binary);
+        return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    }
+
+    void writeFile(const string &bytes)
+    {
+        ofstream out(FILENAME, ios::binary | ios::trunc);
+        out.write(bytes.data(), bytes.size());
+    }
+
+    uint64_t field(const string &bytes, size_t offset)
+    {
+        uint64_t value;
+        memcpy(&value, bytes.data() + offset, sizeof(value));
+        return value;
+    }
+
+    void setWord(string &bytes, size_t offset, uint32_t value)
+    {
+        memcpy(&bytes[offset], &value, sizeof(value));
+    }
+
+    bool attaches(const char *what) // the error is printed only when attach was expected to work
+    {
+        WordCatVec vocabulary;
+        try
+        {
+            vocabulary.attachShared(FILENAME);
+            return true;
+        }
+        catch (const runtime_error &e)
+        {
+            if (what == nullptr)
+            {
+                cout << e.what() << endl;
+            }
+            return false;
+        }
+    }
+}
+
+int main()
+{
+    WordCatVec vocabulary;
+    WordCat animals(Word("animals"));
+    animals.insertWord(Word("cat"));
+    animals.insertWord(Word("dog"));
+    animals.insertWord(Word("cow"));
+    vocabulary.addCategory(move(animals));
+    vocabulary.publishShared(FILENAME);
+
+    string published = readFile();
+    expect(attaches(nullptr), "the published file attaches");
+    {
+        WordCatVec attached;
+        attached.attachShared(FILENAME);
+        const WordCat *category = attached.getCategory("animals");
+        expect(category != nullptr && category->searchWord(Word("cow")) && !category->searchWord(Word("ant")),
+               "the attached category finds its words");
+        expect(category != nullptr && category->stats().words() == 3, "the stats come from the file");
+    }
+
+    string damaged = published;
+    size_t starts = field(published, HEADER + ENTRY_STARTS);
+    setWord(damaged, starts, 0xfffffff0u); // the first word starts far past the end of the mapping
+    writeFile(damaged);
+    expect(!attaches("start out of bounds"), "a start past the blob is rejected");
+
+    damaged = published;
+    setWord(damaged, starts + sizeof(uint32_t), 0); // the second word now starts where the first does, still in bounds
+    writeFile(damaged);
+    expect(!attaches("start in bounds"), "a changed start inside the blob is caught by the checksum");
+
+    damaged = published;
+    setWord(damaged, field(published, HEADER + ENTRY_LENGTHS), 1000); // the first word runs past its blob
+    writeFile(damaged);
+    expect(!attaches("length"), "a length past the blob is rejected");
+
+    writeFile(published.substr(0, published.size() / 2));
+    expect(!attaches("truncated"), "a truncated file is rejected");
+
+    remove(FILENAME);
+    if (failures == 0)
+    {
+        cout << "shared dictionary test passed" << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+// The write-ahead log : a torn record at the end is cut off on open so later records are not lost behind it,
+// a checkpoint leaves an empty log and a log left from before the checkpoint is not replayed again
+// ./word_log_test ; writes word_log_test.log and word_log_test.snap in the current directory, prints each failed check
+#include "WordLog.h"
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+    const char *BASE = "word_log_test";
+    const string LOG_PATH = string(BASE) + ".log";
+    const string SNAPSHOT_PATH = string(BASE) + ".snap";
+    const size_t LOG_HEADER = 16; // magic, generation
+
+    int failures = 0;
+
+    void expect(bool ok, const char *what)
+    {
+        if (!ok)
+        {
+            cout << "FAIL: " << what << endl;
+            ++failures;
+        }
+    }
+
+    string readFile(const string &path)
+    {
+        ifstream in(path.c_str(), ios::binary);
+        return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    }
+
+    void writeFile(const string &path, const string &bytes)
+    {
+        ofstream out(path.c_str(), ios::binary | ios::trunc);
+        out.write(bytes.data(), bytes.size());
+    }
+
+    size_t occurrences(const WordCatVec &vocabulary, const char *category, const char *word)
+    {
+        const WordCat *found = vocabulary.getCategory(category);
+        return found == nullptr ? 0 : found->count(Word(word));
+    }
+
+    // Open the log into a new vocabulary, make the edits of edit, commit them and close everything again
+    template <class Edit>
+    void session(Edit edit)
+    {
+        WordCatVec vocabulary;
+        WordLog log;
+        log.open(BASE, vocabulary);
+        vocabulary.attachLog(&log);
+        edit(vocabulary, log);
+        vocabulary.commitLog();
+    }
+}
+
+int main()
+{
+    remove(LOG_PATH.c_str());
+    remove(SNAPSHOT_PATH.c_str());
+
+    session([](WordCatVec &vocabulary, WordLog &)
+            {
+                vocabulary.addCategory(WordCat(Word("animals")));
+                vocabulary.insertWord("animals", Word("cat"));
+            });
+    string committed = readFile(LOG_PATH);
+    expect(committed.size() > LOG_HEADER, "the edits reach the log");
+
+    writeFile(LOG_PATH, committed + string("\x05\x07\x00", 3)); // a record cut short by a crash
+    session([&committed](WordCatVec &vocabulary, WordLog &)
+            {
+                expect(occurrences(vocabulary, "animals", "cat") == 1, "the records before a torn tail are replayed");
+                expect(readFile(LOG_PATH) == committed, "open cuts the torn tail off the log");
+                vocabulary.insertWord("animals", Word("dog"));
+            });
+    session([](WordCatVec &vocabulary, WordLog &)
+            {
+                expect(occurrences(vocabulary, "animals", "dog") == 1, "a record written after the cut is replayed");
+            });
+
+    string corrupt = readFile(LOG_PATH);
+    corrupt[corrupt.size() - 1] ^= 0x55; // checksum of the last record
+    writeFile(LOG_PATH, corrupt);
+    session([](WordCatVec &vocabulary, WordLog &)
+            {
+                expect(occurrences(vocabulary, "animals", "cat") == 1 && occurrences(vocabulary, "animals", "dog") == 0,
+                       "a corrupt record ends the replay");
+            });
+
+    string before_checkpoint;
+    session([&before_checkpoint](WordCatVec &vocabulary, WordLog &log)
+            {
+                vocabulary.insertWord("animals", Word("cow"));
+                vocabulary.commitLog();
+                before_checkpoint = readFile(LOG_PATH);
+                log.checkpoint(vocabulary);
+                expect(readFile(LOG_PATH).size() == LOG_HEADER, "a checkpoint leaves an empty log");
+            });
+    session([](WordCatVec &vocabulary, WordLog &)
+            {
+                expect(occurrences(vocabulary, "animals", "cat") == 1 && occurrences(vocabulary, "animals", "cow") == 1,
+                       "the snapshot holds the words");
+            });
+
+    writeFile(LOG_PATH, before_checkpoint); // a crash between writing the snapshot and starting the new log
+    session([](WordCatVec &vocabulary, WordLog &)
+            {
+                expect(occurrences(vocabulary, "animals", "cow") == 1, "a log older than the snapshot is not replayed");
+            });
+
+    remove(LOG_PATH.c_str());
+    remove(SNAPSHOT_PATH.c_str());
+    if (failures == 0)
+    {
+        cout << "word log test passed" << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
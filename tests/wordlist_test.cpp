@@ -0,0 +1,83 @@
+// BasicWordList with an ordering policy other than the default : CaseFoldedOrder, with and without the index and counts
+// ./wordlist_test ; prints the first failed check and exits with 1
+#include "WordList.h"
+#include <sstream>
+#include <string>
+
+namespace
+{
+    typedef BasicWordList<Word, CaseFoldedOrder> FoldedList;
+
+    int failures = 0;
+
+    void expect(bool ok, const char *what)
+    {
+        if (!ok)
+        {
+            cout << "FAIL: " << what << endl;
+            ++failures;
+        }
+    }
+
+    string contents(const FoldedList &list)
+    {
+        ostringstream out;
+        out << list;
+        return out.str();
+    }
+
+    FoldedList sortedList(const char *const *words, size_t count)
+    {
+        FoldedList list;
+        for (size_t i = 0; i < count; ++i)
+        {
+            list.insertSorted(Word(words[i]));
+        }
+        return list;
+    }
+}
+
+int main()
+{
+    const char *words[] = {"cherry", "Banana", "apple", "Cat", "cat", "CAT"};
+    const size_t count = sizeof(words) / sizeof(words[0]);
+
+    FoldedList list = sortedList(words, count);
+    expect(contents(list) == "apple Banana CAT cat Cat cherry ", "insertSorted ignores case, a word goes before its equals");
+    expect(list.lookup(Word("BANANA")), "lookup ignores case");
+    expect(list.count(Word("cAt")) == 3, "count ignores case");
+    expect(!list.lookup(Word("ca")), "a prefix is not the word");
+
+    list.enableIndex();
+    expect(list.lookup(Word("APPLE")), "indexed lookup ignores case (the hash is of the folded word)");
+    expect(list.remove(Word("CHERRY")) && !list.lookup(Word("cherry")), "indexed remove ignores case");
+
+    list.enableCounts();
+    expect(list.length() == 3 && list.occurrences() == 5, "counts fold the three spellings of cat into one node");
+    expect(list.count(Word("Cat")) == 3, "counted word");
+
+    const char *more[] = {"avocado", "CHERRY", "bAnana"};
+    FoldedList other = sortedList(more, sizeof(more) / sizeof(more[0]));
+    list.merge(other);
+    expect(other.isEmpty(), "merge empties the other list");
+    expect(list.length() == 5 && list.occurrences() == 8, "merge folds equal words into counts");
+    expect(list.count(Word("banana")) == 2 && list.lookup(Word("Cherry")), "merged words are indexed");
+
+    list.enableCounts(false);
+    expect(contents(list) == "apple avocado Banana Banana CAT CAT CAT CHERRY ", "counts split back in order");
+
+    WordList plain;
+    for (size_t i = 0; i < count; ++i)
+    {
+        plain.insertSorted(Word(words[i]));
+    }
+    ostringstream out;
+    out << plain;
+    expect(out.str() == "Banana CAT Cat apple cat cherry ", "the default order is still strcmp order");
+
+    if (failures == 0)
+    {
+        cout << "wordlist test passed" << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}